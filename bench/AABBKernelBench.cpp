@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////
+// Microbenchmark for the collision overlap kernel.
+// Compares the scalar all-pairs loop against the SIMD kernel,
+// both brute force and through sweep and prune.
+//
+// make microbench && ./AABBKernelBench [num_of_boxes] [iterations]
+///////////////////////////////////////////////////////////////
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../src/Collision/ColliderBounds.hpp"
+#include "../src/Collision/AABBKernel.hpp"
+
+template <typename T_func>
+double time_ms(uint32_t iterations, T_func&& func) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++)
+    func();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+  const uint32_t num_of_boxes = (argc > 1) ? std::atoi(argv[1]) : 4000;
+  const uint32_t iterations = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+  // Roughly the default map, with ship and bullet sized boxes
+  std::mt19937 rng(1337);
+  std::uniform_real_distribution<float> pos_x(0.0f, 2800.0f);
+  std::uniform_real_distribution<float> pos_y(0.0f, 2240.0f);
+  std::uniform_real_distribution<float> size(4.0f, 68.0f);
+
+  ColliderBounds bounds;
+  bounds.reserve(num_of_boxes);
+  for (uint32_t i = 0; i < num_of_boxes; i++)
+    bounds.add(i, pos_x(rng), pos_y(rng), size(rng), size(rng));
+
+  std::vector<CollisionPair> pairs;
+  pairs.reserve(num_of_boxes * 4);
+  size_t scalar_pairs = 0, simd_pairs = 0, sap_pairs = 0;
+
+  const double scalar_ms = time_ms(iterations, [&]() {
+    pairs.clear();
+    for (uint32_t i = 0; i < bounds.size(); i++)
+      AABBKernel::test_scalar(bounds, i, i + 1, bounds.size(), pairs);
+    scalar_pairs = pairs.size();
+  });
+
+  const double simd_ms = time_ms(iterations, [&]() {
+    pairs.clear();
+    AABBKernel::all_pairs(bounds, pairs);
+    simd_pairs = pairs.size();
+  });
+
+  ColliderBounds sorted = bounds;
+  const double sort_ms = time_ms(iterations, [&]() {
+    sorted = bounds;
+    sorted.sort_by_min_x();
+  });
+
+  const double sap_ms = time_ms(iterations, [&]() {
+    pairs.clear();
+    AABBKernel::sweep_and_prune(sorted, pairs);
+    sap_pairs = pairs.size();
+  });
+
+  std::printf("boxes: %u, lanes: %u, iterations: %u\n", num_of_boxes, AABBKernel::LANES, iterations);
+  std::printf("scalar all pairs  %10.3f ms  (%zu pairs)\n", scalar_ms, scalar_pairs);
+  std::printf("simd all pairs    %10.3f ms  (%zu pairs)\n", simd_ms, simd_pairs);
+  std::printf("sort by min x     %10.3f ms\n", sort_ms);
+  std::printf("simd sweep+prune  %10.3f ms  (%zu pairs)\n", sap_ms, sap_pairs);
+
+  if (scalar_pairs != simd_pairs || scalar_pairs != sap_pairs) {
+    std::fprintf(stderr, "pair counts differ!\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////
+// Runs one scenario (see src/Scenario/Scenario.hpp) headless
+// for its number of fixed-dt frames and writes what it cost as
+// JSON: mean/p50/p99/max per system per frame, entities per
+// second, the fewest and most entities in a frame and peak
+// memory, to compare across commits.
+//
+// make bench  (every scenario in bench/scenarios, into bench-results/)
+// ./ScenarioBench scenario_file [--output file.json] [--label text]
+//
+// One scenario per process, so peak memory is its own. Run from
+// the repo root, it loads ./assets.
+///////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "../src/Game/Game.hpp"
+#include "../src/Logger/Logger.hpp"
+#include "../src/Profiler/SystemProfiler.hpp"
+#include "../src/Scenario/Scenario.hpp"
+
+static uint64_t get_peak_rss_kb() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  // Bytes on macOS, KB everywhere else
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+// Scenario names and labels are plain, only quotes and backslashes need escaping
+static std::string json_string(const std::string& text) {
+  std::string escaped = "\"";
+  for (char c: text) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+  }
+  return escaped + "\"";
+}
+
+static void write_stats(FILE* output, const char* indent, const SystemProfiler::Stats& stats) {
+  std::fprintf(output, "%s\"mean_us\": %.3f, \"p50_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f",
+               indent, stats.mean_us, stats.p50_us, stats.p99_us, stats.max_us);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s scenario_file [--output file.json] [--label text]\n", argv[0]);
+    return 1;
+  }
+
+  std::string output_path;
+  std::string label;
+  for (int i = 2; i < argc; i++) {
+    const std::string option = argv[i];
+    if (option == "--output" && i + 1 < argc) output_path = argv[++i];
+    else if (option == "--label" && i + 1 < argc) label = argv[++i];
+    else {
+      std::fprintf(stderr, "unknown option %s\n", option.c_str());
+      return 1;
+    }
+  }
+
+  Scenario scenario;
+  if (!load_scenario(argv[1], scenario)) return 1;
+
+  // Every spawn, removal and collision logs, which would be most of what
+  // gets timed (and most of the peak memory). Errors still come through
+  Logger::set_level(LOG_ERROR);
+
+  Game game;
+  game.headless_enabled = true;
+  game.headless_width = scenario.width;
+  game.headless_height = scenario.height;
+  game.simulation_tick_rate = scenario.tick_rate;
+  game.max_frames = scenario.frames;
+  game.scenario = std::make_unique<Scenario>(scenario);
+  game.profiler = std::make_unique<SystemProfiler>();
+
+  game.Initialize();
+  if (!game.is_running) return 1;
+  game.Run();
+
+  const SystemProfiler& profiler = *game.profiler;
+  const double total_seconds = profiler.get_total_seconds();
+  const uint64_t peak_rss_kb = get_peak_rss_kb();
+
+  // Logging goes to stdout, so the results get a file when asked for one
+  FILE* output = output_path.empty() ? stdout : std::fopen(output_path.c_str(), "w");
+  if (!output) {
+    std::fprintf(stderr, "failed opening %s\n", output_path.c_str());
+    return 1;
+  }
+
+  std::fprintf(output, "{\n");
+  std::fprintf(output, "  \"scenario\": %s,\n", json_string(scenario.name).c_str());
+  std::fprintf(output, "  \"label\": %s,\n", json_string(label).c_str());
+  std::fprintf(output, "  \"parameters\": {\"level\": %d, \"ships\": %u, \"emitters\": %u, \"bullet_patterns\": %u, "
+                       "\"pattern_bullets\": %u, \"pattern_repeat_ms\": %u, \"map_width\": %u, \"map_height\": %u, "
+                       "\"tick_rate\": %u, \"width\": %u, \"height\": %u, \"seed\": %u},\n",
+               scenario.level, scenario.ships, scenario.emitters, scenario.bullet_patterns,
+               scenario.pattern_bullets, scenario.pattern_repeat_ms, scenario.map_width, scenario.map_height,
+               scenario.tick_rate, scenario.width, scenario.height, scenario.seed);
+  std::fprintf(output, "  \"frames\": %u,\n", profiler.get_num_of_frames());
+  std::fprintf(output, "  \"total_seconds\": %.6f,\n", total_seconds);
+  std::fprintf(output, "  \"entities_per_second\": %.0f,\n", total_seconds > 0.0 ? profiler.get_entity_frames() / total_seconds : 0.0);
+  std::fprintf(output, "  \"entities_per_frame\": {\"min\": %u, \"max\": %u},\n", profiler.get_min_entities(), profiler.get_max_entities());
+  std::fprintf(output, "  \"peak_rss_kb\": %llu,\n", static_cast<unsigned long long>(peak_rss_kb));
+
+  std::fprintf(output, "  \"frame\": {");
+  write_stats(output, "", SystemProfiler::get_stats(profiler.get_frame_samples()));
+  std::fprintf(output, "},\n");
+
+  std::fprintf(output, "  \"systems\": {\n");
+  const auto& sections = profiler.get_sections();
+  for (size_t i = 0; i < sections.size(); i++) {
+    std::fprintf(output, "    %s: {", json_string(sections[i].name).c_str());
+    write_stats(output, "", SystemProfiler::get_stats(sections[i].samples));
+    std::fprintf(output, ", \"frames\": %zu}%s\n", sections[i].samples.size(), i + 1 < sections.size() ? "," : "");
+  }
+  std::fprintf(output, "  }\n}\n");
+
+  if (output != stdout) std::fclose(output);
+  game.Destroy();
+  return 0;
+}
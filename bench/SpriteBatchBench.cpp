@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////
+// Sprite throughput of the batched RenderGeometry path against
+// one RenderCopyEx per sprite. Renders into a software renderer
+// on a plain surface so it runs without a GPU or a display.
+//
+// make spritebench && ./SpriteBatchBench [num_of_sprites] [frames] [--no-atlas]
+// (run from the repo root, it loads textures from ./assets)
+///////////////////////////////////////////////////////////////
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../src/AssetManager/AssetManager.hpp"
+#include "../src/RenderQueue/RenderQueue.hpp"
+#include "../src/RenderQueue/SpriteBatcher.hpp"
+
+const int SURFACE_WIDTH = 1280;
+const int SURFACE_HEIGHT = 720;
+
+int main(int argc, char* argv[]) {
+  const uint32_t num_of_sprites = (argc > 1) ? std::atoi(argv[1]) : 10000;
+  const uint32_t frames = (argc > 2) ? std::atoi(argv[2]) : 50;
+
+  SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, SURFACE_WIDTH, SURFACE_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+  SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+  if (!renderer) {
+    std::fprintf(stderr, "Failed to create software renderer: %s\n", SDL_GetError());
+    return 1;
+  }
+
+  auto asset_manager = std::make_unique<AssetManager>();
+  const TextureHandle textures[] = { "bullet-image", "tree-image", "asteroid-image", "planet-image" };
+  asset_manager->add_texture(renderer, "bullet-image", "./assets/images/bullet.png");
+  asset_manager->add_texture(renderer, "tree-image", "./assets/images/tree.png");
+  asset_manager->add_texture(renderer, "asteroid-image", "./assets/images/space/background/Assets/layered/asteroid-1.png");
+  asset_manager->add_texture(renderer, "planet-image", "./assets/images/space/background/Assets/layered/prop-planet-big.png");
+
+  // Pass --no-atlas to keep one texture per image
+  if (argc <= 3 || std::string(argv[3]) != "--no-atlas")
+    asset_manager->build_atlases(renderer);
+
+  // A few textures and z levels so the queue has real runs to find
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> pos_x(-16, SURFACE_WIDTH);
+  std::uniform_int_distribution<int> pos_y(-16, SURFACE_HEIGHT);
+  std::uniform_int_distribution<int> texture(0, 3);
+  std::uniform_int_distribution<int> z_index(0, 3);
+  std::uniform_real_distribution<float> rotation(0.0f, 360.0f);
+
+  RenderQueue render_queue;
+  render_queue.reserve(num_of_sprites);
+  for (uint32_t i = 0; i < num_of_sprites; i++) {
+    const TextureHandle sprite_texture = textures[texture(rng)];
+
+    RenderCommand command;
+    command.texture_page = asset_manager->get_texture_page(sprite_texture);
+    command.src_rect = asset_manager->fold_src_rect(sprite_texture, {0, 0, 32, 32});
+    command.dst_rect = {pos_x(rng), pos_y(rng), 32, 32};
+    command.rotation = (i % 2) ? rotation(rng) : 0.0f;
+    command.flip = (i % 3 == 0) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+    render_queue.push(RENDER_LAYER_WORLD, static_cast<int8_t>(z_index(rng)), command);
+  }
+  render_queue.sort();
+
+  auto sprites_per_second = [&](SpriteBatcher& batcher) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+      SDL_SetRenderDrawColor(renderer, 21, 21, 21, 255);
+      SDL_RenderClear(renderer);
+      batcher.draw(renderer, asset_manager, render_queue);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(num_of_sprites) * frames / std::chrono::duration<double>(end - start).count();
+  };
+
+  SpriteBatcher copy_ex;
+  copy_ex.set_use_geometry(false);
+  SpriteBatcher batched;
+
+  const double copy_ex_rate = sprites_per_second(copy_ex);
+  const double batched_rate = sprites_per_second(batched);
+
+  std::printf("sprites: %u, frames: %u, surface: %dx%d\n", num_of_sprites, frames, SURFACE_WIDTH, SURFACE_HEIGHT);
+  std::printf("RenderCopyEx per sprite  %12.0f sprites/sec\n", copy_ex_rate);
+  std::printf("RenderGeometry batched   %12.0f sprites/sec%s\n", batched_rate, batched.is_using_geometry() ? "" : "  (unsupported, fell back)");
+
+  asset_manager.reset();
+  SDL_DestroyRenderer(renderer);
+  SDL_FreeSurface(surface);
+  return 0;
+}
@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////
+// Check for the static collision layer: a player flies into a
+// block of solid tiles from each side (and corner on) for a
+// couple of seconds of ticks, through MovementSystem and
+// CollisionSystem the way Game::Simulate runs them. Fails if
+// the player ever ends a tick inside a solid tile, or never
+// reaches the block.
+//
+// make tilecheck && ./TileCollisionCheck
+///////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include "../src/ECS/ECS.hpp"
+#include "../src/EventManager/EventManager.hpp"
+#include "../src/Game/Game.hpp"
+#include "../src/ThreadPool/ThreadPool.hpp"
+#include "../src/Tilemap/Tilemap.hpp"
+#include "../src/Collision/TileCollision.hpp"
+#include "../src/Components/TransformComponent.hpp"
+#include "../src/Components/RigidBodyComponent.hpp"
+#include "../src/Components/BoxColliderComponent.hpp"
+#include "../src/Components/CollisionComponent.hpp"
+#include "../src/Systems/MovementSystem.hpp"
+#include "../src/Systems/CollisionSystem.hpp"
+
+const static uint16_t MAP_TILES = 32;
+const static uint16_t TILE_SIZE = 32;
+// The solid block, in tiles, inclusive
+const static uint16_t BLOCK_FIRST = 12;
+const static uint16_t BLOCK_LAST = 19;
+const static uint32_t TICKS = 240;
+const static double TICK = 1.0 / 120.0;
+
+struct Approach {
+  const char* name;
+  glm::vec2 start;
+  glm::vec2 velocity;
+};
+
+// Writes a MAP_TILES square map with the block solid, Tilemap only loads from disk
+static bool write_block_map(const std::string& map_path) {
+  TilemapGrid grid;
+  grid.columns = MAP_TILES;
+  grid.rows = MAP_TILES;
+  grid.tiles.assign(MAP_TILES * MAP_TILES, 0);
+  for (uint16_t row = BLOCK_FIRST; row <= BLOCK_LAST; row++)
+    for (uint16_t column = BLOCK_FIRST; column <= BLOCK_LAST; column++)
+      grid.tiles[row * MAP_TILES + column] = 1;
+
+  const std::vector<uint8_t> image = encode_tilemap(grid, TILEMAP_DEFAULT_CHUNK_TILES, {false, true});
+  std::ofstream file(map_path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(image.data()), image.size());
+  return static_cast<bool>(file);
+}
+
+static bool run(const Tilemap& tilemap, const Approach& approach) {
+  auto registry = std::make_unique<Registry>();
+  auto event_manager = std::make_unique<EventManager>();
+  auto thread_pool = std::make_unique<ThreadPool>(1);
+  registry->add_system<MovementSystem>();
+  registry->add_system<CollisionSystem>();
+
+  Entity tilemap_entity = registry->create_entity();
+  tilemap_entity.tag("tilemap");
+  tilemap_entity.group("object");
+  tilemap_entity.add_component<CollisionComponent>();
+  registry->get_system<CollisionSystem>().set_tilemap(&tilemap, tilemap_entity);
+
+  // Same box as the player ship
+  Entity player = registry->create_entity();
+  player.tag("player");
+  player.add_component<TransformComponent>(approach.start, glm::vec2(2.0, 2.0), 0.0);
+  player.add_component<RigidBodyComponent>();
+  player.add_component<BoxColliderComponent>(34, 33, glm::vec2(14, 15));
+  player.add_component<CollisionComponent>();
+  registry->update();
+
+  const auto& transform = player.get_component<TransformComponent>();
+  const auto& collider = player.get_component<BoxColliderComponent>();
+  bool touched = false;
+
+  for (uint32_t tick = 0; tick < TICKS; tick++) {
+    // Key held down the whole time
+    player.get_component<RigidBodyComponent>().velocity = approach.velocity;
+
+    event_manager->reset();
+    registry->get_system<MovementSystem>().ListenForEvents(event_manager);
+    registry->get_system<MovementSystem>().Update(TICK);
+    registry->get_system<CollisionSystem>().Update(event_manager, thread_pool, TICK);
+    registry->update();
+
+    touched |= player.get_component<CollisionComponent>().is_colliding;
+
+    const float min_x = transform.position.x + collider.offset.x;
+    const float min_y = transform.position.y + collider.offset.y;
+    const float max_x = min_x + collider.width * transform.scale.x;
+    const float max_y = min_y + collider.height * transform.scale.y;
+    if (TileCollision::overlaps_solid(tilemap.get_file(), TILE_SIZE, min_x, min_y, max_x, max_y)) {
+      std::fprintf(stderr, "%s: player inside a solid tile after tick %u, at (%.2f, %.2f)\n", approach.name, tick, transform.position.x, transform.position.y);
+      return false;
+    }
+  }
+
+  if (!touched) {
+    std::fprintf(stderr, "%s: player never reached the block\n", approach.name);
+    return false;
+  }
+  std::printf("%-12s stopped at (%.2f, %.2f)\n", approach.name, transform.position.x, transform.position.y);
+  return true;
+}
+
+int main() {
+  const std::string map_path = (std::filesystem::temp_directory_path() / "TileCollisionCheck.tilemap").string();
+  Tilemap tilemap;
+  if (!write_block_map(map_path) || !tilemap.load(map_path, "check-tiles", TILE_SIZE, 1)) {
+    std::fprintf(stderr, "could not build the check tilemap\n");
+    return 1;
+  }
+
+  Game::map_width = tilemap.get_width();
+  Game::map_height = tilemap.get_height();
+
+  // The block spans 384..640, the ship box is 68x66 offset by (14, 15)
+  const Approach approaches[] = {
+    {"from left", glm::vec2(200, 460), glm::vec2(320, 0)},
+    {"from right", glm::vec2(700, 460), glm::vec2(-320, 0)},
+    {"from above", glm::vec2(460, 200), glm::vec2(0, 320)},
+    {"from below", glm::vec2(460, 700), glm::vec2(0, -320)},
+    {"corner on", glm::vec2(220, 220), glm::vec2(320, 320)},
+  };
+
+  bool passed = true;
+  for (const auto& approach: approaches)
+    passed &= run(tilemap, approach);
+
+  tilemap.clear();
+  std::filesystem::remove(map_path);
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Small integer stand-in for an asset id string. The string is
+// looked up once, when the handle is made (normally when the
+// component holding it is created), and every asset id gets
+// the same number for the life of the program. AssetManager
+// keeps its textures/fonts in arrays indexed by that number,
+// so the render loop never hashes or compares a string.
+//
+// Handles can be made before the asset is loaded, AssetManager
+// just has nothing at that index until it is.
+///////////////////////////////////////////////////////////////
+template <typename T_asset>
+struct AssetHandle {
+  const static uint16_t INVALID = 0xFFFF;
+  uint16_t index;
+
+  AssetHandle() : index{INVALID} {}
+  AssetHandle(const std::string& asset_id) : index{intern(asset_id)} {}
+  AssetHandle(const char* asset_id) : AssetHandle(std::string(asset_id)) {}
+
+  bool is_valid() const { return index != INVALID; }
+  bool operator==(const AssetHandle& other) const { return index == other.index; }
+  bool operator!=(const AssetHandle& other) const { return index != other.index; }
+
+  const std::string& get_asset_id() const {
+    static const std::string none;
+    return is_valid() ? names().ids[index] : none;
+  }
+
+private:
+  struct Names {
+    std::unordered_map<std::string, uint16_t> indices;
+    std::vector<std::string> ids;
+  };
+
+  static Names& names() {
+    static Names table;
+    return table;
+  }
+
+  static uint16_t intern(const std::string& asset_id) {
+    if (asset_id.empty()) return INVALID;
+
+    auto& table = names();
+    auto existing = table.indices.find(asset_id);
+    if (existing != table.indices.end()) return existing->second;
+
+    const uint16_t new_index = static_cast<uint16_t>(table.ids.size());
+    table.indices.emplace(asset_id, new_index);
+    table.ids.push_back(asset_id);
+    return new_index;
+  }
+};
+
+struct TextureAsset {};
+struct FontAsset {};
+
+typedef AssetHandle<TextureAsset> TextureHandle;
+typedef AssetHandle<FontAsset> FontHandle;
+
+static_assert(std::is_trivially_copyable<TextureHandle>::value, "handles are copied around as plain data");
@@ -1,9 +1,11 @@
 #include "./AssetManager.hpp"
+#include "./SkylinePacker.hpp"
 #include "../Logger/Logger.hpp"
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_render.h>
 #include <SDL2/SDL_surface.h>
 #include <SDL2/SDL_ttf.h>
+#include <algorithm>
 
 AssetManager::AssetManager() { Logger::Log("AssetManager Constructor called!"); }
 
@@ -13,32 +15,167 @@ AssetManager::~AssetManager() {
 }
 
 void AssetManager::clear_assets() {
-  for (auto texture: textures)
-    SDL_DestroyTexture(texture.second);
-  // This only clears the map, not the SDL
+  for (auto texture: page_textures)
+    if (texture) SDL_DestroyTexture(texture);
+  // This only clears the vector, not the SDL
   // heap memory! Hence above^
-  textures.clear();
+  page_textures.clear();
+  page_sizes.clear();
 
-  for (auto font: fonts)
-    TTF_CloseFont(font.second);
-  fonts.clear();
+  for (auto surface: texture_surfaces)
+    if (surface) SDL_FreeSurface(surface);
+  texture_surfaces.clear();
+
+  texture_pages.clear();
+  texture_regions.clear();
+
+  // Cached text belongs to the fonts
+  text_cache.clear();
+  glyph_atlases.clear();
+  for (auto font: font_list)
+    if (font) TTF_CloseFont(font);
+  font_list.clear();
+}
+
+uint16_t AssetManager::add_page(SDL_Texture* texture) {
+  SDL_Point size = {0, 0};
+  SDL_QueryTexture(texture, NULL, NULL, &size.x, &size.y);
+
+  page_textures.push_back(texture);
+  page_sizes.push_back(size);
+  return static_cast<uint16_t>(page_textures.size() - 1);
+}
+
+void AssetManager::release_page(uint16_t page) {
+  if (page_textures[page]) SDL_DestroyTexture(page_textures[page]);
+  page_textures[page] = nullptr;
+}
+
+void AssetManager::reserve_texture_slot(TextureHandle texture) {
+  if (texture.index < texture_pages.size()) return;
+
+  texture_pages.resize(texture.index + 1, NO_PAGE);
+  texture_regions.resize(texture.index + 1, SDL_Rect {0, 0, 0, 0});
+  texture_surfaces.resize(texture.index + 1, nullptr);
 }
 
-void AssetManager::add_texture(SDL_Renderer* renderer, const std::string& asset_id, const std::string& file_path) {
+void AssetManager::add_texture(SDL_Renderer* renderer, TextureHandle texture, const std::string& file_path) {
+  const std::string& asset_id = texture.get_asset_id();
   SDL_Surface* surface = IMG_Load(file_path.c_str());
-  SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-  SDL_FreeSurface(surface);
+  // Still registered so the handle resolves, it just draws nothing
+  if (!surface)
+    Logger::Err("Failed loading texture [" + asset_id + "] from " + file_path + ": " + IMG_GetError());
+
+  const uint16_t page = add_page(surface ? SDL_CreateTextureFromSurface(renderer, surface) : nullptr);
+  const SDL_Rect region = {0, 0, surface ? surface->w : 0, surface ? surface->h : 0};
+
+  reserve_texture_slot(texture);
+  const uint16_t old_page = texture_pages[texture.index];
+  texture_pages[texture.index] = page;
+  texture_regions[texture.index] = region;
 
-  textures.emplace(asset_id, texture);
+  // Reloading keeps the handle so anything holding it stays valid. The
+  // old page only goes if nothing else was packed onto it
+  if (old_page != NO_PAGE && std::find(texture_pages.begin(), texture_pages.end(), old_page) == texture_pages.end())
+    release_page(old_page);
+
+  if (texture_surfaces[texture.index]) SDL_FreeSurface(texture_surfaces[texture.index]);
+  texture_surfaces[texture.index] = surface;
 
   Logger::Log("New texture added to asset manager with ID [" + asset_id + "]!");
 }
 
-// TODO: Add error checking later
-SDL_Texture* AssetManager::get_texture(const std::string& asset_id) const { return textures.at(asset_id); }
+void AssetManager::build_atlases(SDL_Renderer* renderer) {
+  // Tallest first packs tightest on a skyline
+  std::vector<uint16_t> order;
+  for (uint16_t texture_id = 0; texture_id < texture_surfaces.size(); texture_id++) {
+    const SDL_Surface* surface = texture_surfaces[texture_id];
+    if (surface && surface->w + ATLAS_PADDING <= ATLAS_PAGE_SIZE && surface->h + ATLAS_PADDING <= ATLAS_PAGE_SIZE)
+      order.push_back(texture_id);
+  }
+  if (order.size() < 2) return;
+
+  std::stable_sort(order.begin(), order.end(), [this](uint16_t lhs, uint16_t rhs) {
+    return texture_surfaces[lhs]->h > texture_surfaces[rhs]->h;
+  });
+
+  std::vector<SkylinePacker> packers;
+  std::vector<SDL_Surface*> atlases;
+  std::vector<uint16_t> atlas_of(texture_surfaces.size());
+  std::vector<SDL_Rect> placed(texture_surfaces.size());
+
+  for (auto texture_id: order) {
+    SDL_Surface* image = texture_surfaces[texture_id];
+    int32_t x = 0, y = 0;
+    uint32_t atlas = 0;
+
+    while (atlas < packers.size() && !packers[atlas].insert(image->w + ATLAS_PADDING, image->h + ATLAS_PADDING, x, y))
+      atlas++;
+
+    if (atlas == packers.size()) {
+      packers.emplace_back(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+      atlases.push_back(SDL_CreateRGBSurfaceWithFormat(0, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, 32, SDL_PIXELFORMAT_ARGB8888));
+      packers.back().insert(image->w + ATLAS_PADDING, image->h + ATLAS_PADDING, x, y);
+    }
+
+    // Straight copy, alpha included, rather than blending onto the page
+    SDL_Rect destination = {x, y, image->w, image->h};
+    SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(image, NULL, atlases[atlas], &destination);
+
+    atlas_of[texture_id] = static_cast<uint16_t>(atlas);
+    placed[texture_id] = destination;
+  }
+
+  std::vector<uint16_t> atlas_pages;
+  for (auto atlas_surface: atlases) {
+    atlas_pages.push_back(add_page(SDL_CreateTextureFromSurface(renderer, atlas_surface)));
+    SDL_FreeSurface(atlas_surface);
+  }
+
+  for (auto texture_id: order) {
+    release_page(texture_pages[texture_id]);
+    texture_pages[texture_id] = atlas_pages[atlas_of[texture_id]];
+    texture_regions[texture_id] = placed[texture_id];
+
+    SDL_FreeSurface(texture_surfaces[texture_id]);
+    texture_surfaces[texture_id] = nullptr;
+  }
+
+  Logger::Log("Packed [" + std::to_string(order.size()) + "] textures into [" + std::to_string(atlases.size()) + "] atlas page(s)!");
+}
+
+SDL_Rect AssetManager::fold_src_rect(TextureHandle texture, const SDL_Rect& src_rect) const {
+  const SDL_Rect& region = texture_regions[texture.index];
+
+  const int x0 = std::clamp(src_rect.x, 0, region.w);
+  const int y0 = std::clamp(src_rect.y, 0, region.h);
+  const int x1 = std::clamp(src_rect.x + src_rect.w, 0, region.w);
+  const int y1 = std::clamp(src_rect.y + src_rect.h, 0, region.h);
+
+  return {region.x + x0, region.y + y0, x1 - x0, y1 - y0};
+}
+
+void AssetManager::add_font(FontHandle font, const std::string& file_path, uint16_t font_size) {
+  if (font.index >= font_list.size())
+    font_list.resize(font.index + 1, nullptr);
 
-void AssetManager::add_font(const std::string& asset_id, const std::string& file_path, uint16_t font_size) {
-  fonts.emplace(asset_id, TTF_OpenFont(file_path.c_str(), font_size));
+  if (font_list[font.index]) {
+    // Anything already drawn with the old font goes with it
+    text_cache.clear();
+    if (font.index < glyph_atlases.size()) glyph_atlases[font.index].reset();
+    TTF_CloseFont(font_list[font.index]);
+  }
+  font_list[font.index] = TTF_OpenFont(file_path.c_str(), font_size);
 }
 
-TTF_Font* AssetManager::get_font(const std::string& asset_id) { return fonts.at(asset_id); }
+GlyphAtlas* AssetManager::get_glyph_atlas(SDL_Renderer* renderer, FontHandle font) {
+  TTF_Font* ttf_font = get_font(font);
+  if (!ttf_font) return nullptr;
+
+  if (font.index >= glyph_atlases.size())
+    glyph_atlases.resize(font.index + 1);
+  if (!glyph_atlases[font.index])
+    glyph_atlases[font.index] = std::make_unique<GlyphAtlas>(renderer, ttf_font);
+  return glyph_atlases[font.index].get();
+}
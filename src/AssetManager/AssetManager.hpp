@@ -1,10 +1,33 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include "./AssetHandle.hpp"
+#include "./GlyphAtlas.hpp"
+#include "./TextCache.hpp"
 
+// Atlas pages are square, images bigger than this keep their own texture
+const int32_t ATLAS_PAGE_SIZE = 1024;
+// Transparent gap between packed images so filtering never samples a neighbour
+const int32_t ATLAS_PADDING = 1;
+
+///////////////////////////////////////////////////////////////
+// Every texture lives on a page (an SDL_Texture) at a region
+// of it. Loaded images start out on a page of their own, once
+// build_atlases() runs they're packed together onto as few
+// pages as possible so sprites from different images can be
+// drawn in one batch.
+//
+// Asset ids keep working either way, get_texture() gives the
+// page and fold_src_rect() moves a src rect into the region.
+//
+// Everything is stored in arrays indexed by the asset's handle
+// (see AssetHandle.hpp), a string only becomes a handle once.
+///////////////////////////////////////////////////////////////
 class AssetManager {
 public:
   AssetManager();
@@ -12,14 +35,58 @@ public:
 
   void clear_assets();
 
-  void add_texture(SDL_Renderer* renderer, const std::string& asset_id, const std::string& file_path);
-  SDL_Texture* get_texture(const std::string& asset_id) const;
+  void add_texture(SDL_Renderer* renderer, TextureHandle texture, const std::string& file_path);
+  SDL_Texture* get_texture(TextureHandle texture) const { return page_textures[texture_pages[texture.index]]; }
+  bool has_texture(TextureHandle texture) const { return texture.index < texture_pages.size() && texture_pages[texture.index] != NO_PAGE; }
+
+  // Packs every image loaded so far into atlas pages
+  void build_atlases(SDL_Renderer* renderer);
+
+  // The page is small enough to pack into a render sort key
+  uint16_t get_texture_page(TextureHandle texture) const { return texture_pages[texture.index]; }
+  const SDL_Rect& get_texture_region(TextureHandle texture) const { return texture_regions[texture.index]; }
+
+  // Clamps src_rect to the image and offsets it into its region. SDL
+  // would clip an oversized src rect at the texture edge, on an atlas
+  // the edge is the region's
+  SDL_Rect fold_src_rect(TextureHandle texture, const SDL_Rect& src_rect) const;
+
+  SDL_Texture* get_page_texture(uint16_t page) const { return page_textures[page]; }
+  SDL_Point get_page_size(uint16_t page) const { return page_sizes[page]; }
+  uint16_t get_num_of_pages() const { return static_cast<uint16_t>(page_textures.size()); }
+
+  void add_font(FontHandle font, const std::string& file_path, uint16_t font_size);
+  TTF_Font* get_font(FontHandle font) const { return font.index < font_list.size() ? font_list[font.index] : nullptr; }
 
-  void add_font(const std::string& asset_id, const std::string& file_path, uint16_t font_size);
-  TTF_Font* get_font(const std::string& asset_id);
+  // Text rendered with one of the fonts, cached until it falls out of the budget
+  TextTexture get_text(SDL_Renderer* renderer, FontHandle font, const std::string& text, const SDL_Color& color) {
+    return text_cache.get(renderer, get_font(font), font, text, color);
+  }
+  const TextCache& get_text_cache() const { return text_cache; }
+
+  // Glyph atlas for text that changes every frame, made the first time it's asked for
+  GlyphAtlas* get_glyph_atlas(SDL_Renderer* renderer, FontHandle font);
 
 private:
-  std::map<std::string, SDL_Texture*> textures;
-  std::map<std::string, TTF_Font*> fonts;
+  const static uint16_t NO_PAGE = 0xFFFF;
+
+  // Vector index = TextureHandle index
+  std::vector<uint16_t> texture_pages;
+  std::vector<SDL_Rect> texture_regions;
+  // Decoded pixels, kept until the image has been packed
+  std::vector<SDL_Surface*> texture_surfaces;
+
+  // Vector index = page, a page freed by packing is left as a nullptr
+  std::vector<SDL_Texture*> page_textures;
+  std::vector<SDL_Point> page_sizes;
+
+  // Vector index = FontHandle index
+  std::vector<TTF_Font*> font_list;
+  TextCache text_cache;
+  std::vector<std::unique_ptr<GlyphAtlas>> glyph_atlases;
   // TODO: Audio map  
+
+  void reserve_texture_slot(TextureHandle texture);
+  uint16_t add_page(SDL_Texture* texture);
+  void release_page(uint16_t page);
 };
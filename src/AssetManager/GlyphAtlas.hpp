@@ -0,0 +1,192 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "../Logger/Logger.hpp"
+#include "./SkylinePacker.hpp"
+
+// One page per font, plenty for Latin-1 at HUD sizes
+const int32_t GLYPH_ATLAS_SIZE = 512;
+const int32_t GLYPH_PADDING = 1;
+
+///////////////////////////////////////////////////////////////
+// Every glyph of one font, rasterized white the first time it
+// is drawn and packed into a single texture. Strings are laid
+// out here on the CPU (advance + kerning) and queued as quads,
+// tinted through the vertex color, then flush() draws all of
+// them with one SDL_RenderGeometry call.
+//
+// Text that changes every frame (fps, score) costs no
+// rasterizing and no texture uploads once its glyphs are in.
+//
+// Characters are read as Latin-1 bytes, the same as
+// TTF_RenderText_*. Without RenderGeometry (SDL < 2.0.18, or the
+// renderer refuses it) each glyph is a color modded RenderCopy.
+///////////////////////////////////////////////////////////////
+class GlyphAtlas {
+public:
+  GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font) : font{font}, packer{GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE} {
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE);
+    if (!texture) {
+      Logger::Err(std::string("Failed creating glyph atlas: ") + SDL_GetError());
+      return;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    // Static textures start out undefined, the gaps between glyphs must be clear
+    const std::vector<uint32_t> clear(GLYPH_ATLAS_SIZE * GLYPH_ATLAS_SIZE, 0);
+    SDL_UpdateTexture(texture, NULL, clear.data(), GLYPH_ATLAS_SIZE * sizeof(uint32_t));
+  }
+
+  ~GlyphAtlas() {
+    if (texture) SDL_DestroyTexture(texture);
+  }
+
+  GlyphAtlas(const GlyphAtlas&) = delete;
+  GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+  // Queues text with its top left at (x, y), returns the width it took
+  int32_t queue_text(const std::string& text, float x, float y, const SDL_Color& color) {
+    if (!texture) return 0;
+
+    int32_t pen_x = 0;
+    uint8_t previous = 0;
+
+    for (const char c: text) {
+      const uint8_t character = static_cast<uint8_t>(c);
+      const Glyph& glyph = get_glyph(character);
+
+      if (previous) pen_x += TTF_GetFontKerningSizeGlyphs(font, previous, character);
+      previous = character;
+
+      if (glyph.region.w > 0)
+        quads.push_back({glyph.region, {x + pen_x, y, static_cast<float>(glyph.region.w), static_cast<float>(glyph.region.h)}, color});
+      pen_x += glyph.advance;
+    }
+    return pen_x;
+  }
+
+  // Draws everything queued since the last flush
+  void flush(SDL_Renderer* renderer) {
+    if (quads.empty()) return;
+    if (!use_geometry || !draw_geometry(renderer))
+      draw_fallback(renderer);
+    quads.clear();
+  }
+
+private:
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  const static bool GEOMETRY_SUPPORTED = true;
+#else
+  const static bool GEOMETRY_SUPPORTED = false;
+#endif
+
+  struct Glyph {
+    SDL_Rect region = {0, 0, 0, 0};
+    int16_t advance = 0;
+    bool is_loaded = false;
+  };
+
+  struct Quad {
+    SDL_Rect src_rect;
+    SDL_FRect dst_rect;
+    SDL_Color color;
+  };
+
+  TTF_Font* font;
+  SDL_Texture* texture = nullptr;
+  SkylinePacker packer;
+  Glyph glyphs[256];
+
+  bool use_geometry = GEOMETRY_SUPPORTED;
+  std::vector<Quad> quads;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<SDL_Vertex> vertices;
+#endif
+  std::vector<int> indices;
+
+  const Glyph& get_glyph(uint8_t character) {
+    Glyph& glyph = glyphs[character];
+    if (glyph.is_loaded) return glyph;
+    // Tried once either way, a glyph the font lacks stays empty
+    glyph.is_loaded = true;
+
+    int min_x, max_x, min_y, max_y, advance;
+    if (TTF_GlyphMetrics(font, character, &min_x, &max_x, &min_y, &max_y, &advance) != 0) return glyph;
+    glyph.advance = static_cast<int16_t>(advance);
+
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, character, white);
+    if (!rendered) return glyph;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(rendered);
+    if (!surface) return glyph;
+
+    int32_t x, y;
+    if (packer.insert(surface->w + GLYPH_PADDING, surface->h + GLYPH_PADDING, x, y)) {
+      glyph.region = {x, y, surface->w, surface->h};
+      SDL_UpdateTexture(texture, &glyph.region, surface->pixels, surface->pitch);
+    }
+    else {
+      Logger::Warn("Glyph atlas is full, character " + std::to_string(character) + " won't be drawn");
+    }
+    SDL_FreeSurface(surface);
+    return glyph;
+  }
+
+  bool draw_geometry(SDL_Renderer* renderer) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const float inverse_size = 1.0f / GLYPH_ATLAS_SIZE;
+
+    vertices.clear();
+    for (const auto& quad: quads) {
+      const float u0 = quad.src_rect.x * inverse_size;
+      const float v0 = quad.src_rect.y * inverse_size;
+      const float u1 = (quad.src_rect.x + quad.src_rect.w) * inverse_size;
+      const float v1 = (quad.src_rect.y + quad.src_rect.h) * inverse_size;
+      const float x0 = quad.dst_rect.x;
+      const float y0 = quad.dst_rect.y;
+      const float x1 = quad.dst_rect.x + quad.dst_rect.w;
+      const float y1 = quad.dst_rect.y + quad.dst_rect.h;
+
+      vertices.push_back({{x0, y0}, quad.color, {u0, v0}});
+      vertices.push_back({{x1, y0}, quad.color, {u1, v0}});
+      vertices.push_back({{x1, y1}, quad.color, {u1, v1}});
+      vertices.push_back({{x0, y1}, quad.color, {u0, v1}});
+    }
+
+    const uint32_t num_of_quads = static_cast<uint32_t>(quads.size());
+    for (uint32_t quad = static_cast<uint32_t>(indices.size() / 6); quad < num_of_quads; quad++) {
+      const int first = static_cast<int>(quad * 4);
+      indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    if (SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(num_of_quads * 6)) != 0) {
+      Logger::Warn(std::string("SDL_RenderGeometry failed, drawing glyphs one by one: ") + SDL_GetError());
+      use_geometry = false;
+      return false;
+    }
+    return true;
+#else
+    (void)renderer;
+    return false;
+#endif
+  }
+
+  void draw_fallback(SDL_Renderer* renderer) {
+    for (const auto& quad: quads) {
+      SDL_SetTextureColorMod(texture, quad.color.r, quad.color.g, quad.color.b);
+      SDL_SetTextureAlphaMod(texture, quad.color.a);
+      const SDL_Rect dst_rect = {
+        static_cast<int>(quad.dst_rect.x), static_cast<int>(quad.dst_rect.y),
+        static_cast<int>(quad.dst_rect.w), static_cast<int>(quad.dst_rect.h)
+      };
+      SDL_RenderCopy(renderer, texture, &quad.src_rect, &dst_rect);
+    }
+    SDL_SetTextureColorMod(texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(texture, 255);
+  }
+};
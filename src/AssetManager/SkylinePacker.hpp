@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Skyline rectangle packer for building texture atlases.
+// The packed area is tracked as its top outline (a list of
+// horizontal segments). A rect goes wherever it would sit
+// lowest, ties going to the narrowest fit, which wastes little
+// space when rects are fed in tallest first.
+///////////////////////////////////////////////////////////////
+class SkylinePacker {
+public:
+  SkylinePacker(int32_t width, int32_t height) : width{width}, height{height} {
+    skyline.push_back({0, 0, width});
+  }
+
+  // Finds room for a width x height rect, returns false when the page is full
+  bool insert(int32_t rect_width, int32_t rect_height, int32_t& out_x, int32_t& out_y) {
+    int32_t best_y = std::numeric_limits<int32_t>::max();
+    int32_t best_width = std::numeric_limits<int32_t>::max();
+    int32_t best_index = -1;
+
+    for (uint32_t i = 0; i < skyline.size(); i++) {
+      int32_t y;
+      if (!fits(i, rect_width, rect_height, y)) continue;
+
+      if (y < best_y || (y == best_y && skyline[i].width < best_width)) {
+        best_y = y;
+        best_width = skyline[i].width;
+        best_index = static_cast<int32_t>(i);
+      }
+    }
+
+    if (best_index < 0) return false;
+
+    out_x = skyline[best_index].x;
+    out_y = best_y;
+    add_segment(best_index, out_x, best_y + rect_height, rect_width);
+    return true;
+  }
+
+private:
+  struct Segment {
+    int32_t x;
+    int32_t y;
+    int32_t width;
+  };
+
+  int32_t width;
+  int32_t height;
+  std::vector<Segment> skyline;
+
+  // The rect starting at segment i rests on the highest segment it spans
+  bool fits(uint32_t i, int32_t rect_width, int32_t rect_height, int32_t& y) const {
+    if (skyline[i].x + rect_width > width) return false;
+
+    int32_t width_left = rect_width;
+    y = skyline[i].y;
+
+    while (width_left > 0) {
+      if (i >= skyline.size()) return false;
+      if (skyline[i].y > y) y = skyline[i].y;
+      if (y + rect_height > height) return false;
+
+      width_left -= skyline[i].width;
+      i++;
+    }
+    return true;
+  }
+
+  // Raise the outline under the new rect, trimming or dropping the
+  // segments it now covers and merging equal heights
+  void add_segment(uint32_t index, int32_t x, int32_t y, int32_t segment_width) {
+    skyline.insert(skyline.begin() + index, {x, y, segment_width});
+
+    for (uint32_t i = index + 1; i < skyline.size(); i++) {
+      const int32_t covered_until = skyline[i - 1].x + skyline[i - 1].width;
+      if (skyline[i].x >= covered_until) break;
+
+      const int32_t shrink = covered_until - skyline[i].x;
+      skyline[i].x += shrink;
+      skyline[i].width -= shrink;
+
+      if (skyline[i].width > 0) break;
+      skyline.erase(skyline.begin() + i);
+      i--;
+    }
+
+    for (uint32_t i = 0; i + 1 < skyline.size(); i++) {
+      if (skyline[i].y == skyline[i + 1].y) {
+        skyline[i].width += skyline[i + 1].width;
+        skyline.erase(skyline.begin() + i + 1);
+        i--;
+      }
+    }
+  }
+};
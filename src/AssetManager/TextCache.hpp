@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "./AssetHandle.hpp"
+
+// Default budget for rendered text, counted as 4 bytes a pixel
+const uint32_t TEXT_CACHE_BUDGET = 8 * 1024 * 1024;
+
+struct TextTexture {
+  SDL_Texture* texture;
+  int32_t width;
+  int32_t height;
+};
+
+///////////////////////////////////////////////////////////////
+// Rendered text textures, keyed by (font, string, color). A
+// label only goes through TTF_RenderText_Blended the first
+// frame it reads the way it does; after that drawing it is a
+// lookup and a RenderCopy. Text that changes (fps, score) just
+// makes a new entry.
+//
+// Entries are kept in least recently used order and the oldest
+// are destroyed once the textures add up to more than the byte
+// budget. The entry asked for last is never evicted, so a
+// texture handed out stays valid until the next get().
+///////////////////////////////////////////////////////////////
+class TextCache {
+public:
+  TextCache(uint32_t budget_bytes = TEXT_CACHE_BUDGET) : budget_bytes{budget_bytes} {}
+  ~TextCache() { clear(); }
+
+  TextCache(const TextCache&) = delete;
+  TextCache& operator=(const TextCache&) = delete;
+
+  // Empty text, a missing font or a failed render give a null texture
+  TextTexture get(SDL_Renderer* renderer, TTF_Font* font, FontHandle font_handle, const std::string& text, const SDL_Color& color) {
+    if (text.empty() || !font) return {nullptr, 0, 0};
+
+    const Key key = {font_handle.index, pack_color(color), text};
+    auto cached = entries.find(key);
+    if (cached != entries.end()) {
+      hits++;
+      // Move to the front, the iterator stays valid
+      lru.splice(lru.begin(), lru, cached->second);
+      return cached->second->text_texture;
+    }
+
+    misses++;
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
+    if (!surface) return {nullptr, 0, 0};
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    const TextTexture text_texture = {texture, surface->w, surface->h};
+    SDL_FreeSurface(surface);
+    if (!texture) return {nullptr, 0, 0};
+
+    lru.push_front({key, text_texture, static_cast<uint32_t>(text_texture.width * text_texture.height * 4)});
+    entries.emplace(key, lru.begin());
+    used_bytes += lru.front().bytes;
+
+    evict();
+    return text_texture;
+  }
+
+  void clear() {
+    for (auto& entry: lru)
+      SDL_DestroyTexture(entry.text_texture.texture);
+    lru.clear();
+    entries.clear();
+    used_bytes = 0;
+  }
+
+  uint32_t get_used_bytes() const { return used_bytes; }
+  uint32_t get_num_of_entries() const { return static_cast<uint32_t>(lru.size()); }
+  uint32_t get_hits() const { return hits; }
+  uint32_t get_misses() const { return misses; }
+
+private:
+  struct Key {
+    uint16_t font;
+    uint32_t color;
+    std::string text;
+
+    bool operator==(const Key& other) const { return font == other.font && color == other.color && text == other.text; }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t hash = std::hash<std::string>()(key.text);
+      hash ^= (static_cast<size_t>(key.color) << 16 ^ key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    TextTexture text_texture;
+    uint32_t bytes;
+  };
+
+  uint32_t budget_bytes;
+  uint32_t used_bytes = 0;
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+
+  // Front = most recently used
+  std::list<Entry> lru;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries;
+
+  static uint32_t pack_color(const SDL_Color& color) {
+    return (static_cast<uint32_t>(color.r) << 24) | (color.g << 16) | (color.b << 8) | color.a;
+  }
+
+  void evict() {
+    while (used_bytes > budget_bytes && lru.size() > 1) {
+      Entry& oldest = lru.back();
+      SDL_DestroyTexture(oldest.text_texture.texture);
+      used_bytes -= oldest.bytes;
+      entries.erase(oldest.key);
+      lru.pop_back();
+    }
+  }
+};
@@ -0,0 +1,172 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////
+// Every live bullet-hell bullet, stored as a struct of arrays.
+// Bullets aren't entities, a bullet is just its slot here, so
+// moving and expiring 100k of them is a few linear passes the
+// compiler can keep in registers (4/8 bullets at a time with
+// SSE/AVX, the leftover tail is done scalar).
+//
+// Removal swaps the last bullet into the hole, so slots are
+// not stable between frames. Nothing outside holds onto them.
+///////////////////////////////////////////////////////////////
+struct BulletBuffer {
+  std::vector<float> position_x;
+  std::vector<float> position_y;
+  std::vector<float> velocity_x;
+  std::vector<float> velocity_y;
+  // Seconds left to live, counts down with the simulation step
+  std::vector<float> lifetime;
+  std::vector<uint16_t> damage;
+  std::vector<uint8_t> is_friendly;
+
+  // Step the positions were last moved by, rendering uses it to
+  // blend back towards the previous tick
+  float last_step = 0.0f;
+
+  uint32_t size() const { return static_cast<uint32_t>(position_x.size()); }
+
+  void clear() {
+    position_x.clear();
+    position_y.clear();
+    velocity_x.clear();
+    velocity_y.clear();
+    lifetime.clear();
+    damage.clear();
+    is_friendly.clear();
+  }
+
+  void reserve(uint32_t capacity) {
+    position_x.reserve(capacity);
+    position_y.reserve(capacity);
+    velocity_x.reserve(capacity);
+    velocity_y.reserve(capacity);
+    lifetime.reserve(capacity);
+    damage.reserve(capacity);
+    is_friendly.reserve(capacity);
+  }
+
+  void add(float x, float y, float vx, float vy, float seconds, uint16_t bullet_damage, bool friendly) {
+    position_x.push_back(x);
+    position_y.push_back(y);
+    velocity_x.push_back(vx);
+    velocity_y.push_back(vy);
+    lifetime.push_back(seconds);
+    damage.push_back(bullet_damage);
+    is_friendly.push_back(friendly ? 1 : 0);
+  }
+
+  // Marks a bullet to be dropped by the next remove_expired()
+  void kill(uint32_t slot) { lifetime[slot] = 0.0f; }
+
+  void integrate(float delta_time) {
+    const uint32_t count = size();
+    uint32_t i = 0;
+    last_step = delta_time;
+
+#if defined(__AVX__)
+    const __m256 dt = _mm256_set1_ps(delta_time);
+    for (; i + 8 <= count; i += 8) {
+      _mm256_storeu_ps(&position_x[i], _mm256_add_ps(_mm256_loadu_ps(&position_x[i]), _mm256_mul_ps(_mm256_loadu_ps(&velocity_x[i]), dt)));
+      _mm256_storeu_ps(&position_y[i], _mm256_add_ps(_mm256_loadu_ps(&position_y[i]), _mm256_mul_ps(_mm256_loadu_ps(&velocity_y[i]), dt)));
+      _mm256_storeu_ps(&lifetime[i], _mm256_sub_ps(_mm256_loadu_ps(&lifetime[i]), dt));
+    }
+#elif defined(__SSE2__)
+    const __m128 dt = _mm_set1_ps(delta_time);
+    for (; i + 4 <= count; i += 4) {
+      _mm_storeu_ps(&position_x[i], _mm_add_ps(_mm_loadu_ps(&position_x[i]), _mm_mul_ps(_mm_loadu_ps(&velocity_x[i]), dt)));
+      _mm_storeu_ps(&position_y[i], _mm_add_ps(_mm_loadu_ps(&position_y[i]), _mm_mul_ps(_mm_loadu_ps(&velocity_y[i]), dt)));
+      _mm_storeu_ps(&lifetime[i], _mm_sub_ps(_mm_loadu_ps(&lifetime[i]), dt));
+    }
+#endif
+
+    for (; i < count; i++) {
+      position_x[i] += velocity_x[i] * delta_time;
+      position_y[i] += velocity_y[i] * delta_time;
+      lifetime[i] -= delta_time;
+    }
+  }
+
+  // Drops bullets that ran out of time, were killed, or left the
+  // [0, width) x [0, height) playfield
+  void remove_expired(float width, float height) {
+    const uint32_t count = size();
+    uint32_t i = 0;
+    expired.clear();
+
+#if defined(__AVX__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 max_x = _mm256_set1_ps(width);
+    const __m256 max_y = _mm256_set1_ps(height);
+    for (; i + 8 <= count; i += 8) {
+      const __m256 x = _mm256_loadu_ps(&position_x[i]);
+      const __m256 y = _mm256_loadu_ps(&position_y[i]);
+      __m256 dead = _mm256_cmp_ps(_mm256_loadu_ps(&lifetime[i]), zero, _CMP_LE_OQ);
+      dead = _mm256_or_ps(dead, _mm256_or_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_cmp_ps(x, max_x, _CMP_GE_OQ)));
+      dead = _mm256_or_ps(dead, _mm256_or_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_cmp_ps(y, max_y, _CMP_GE_OQ)));
+
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(dead));
+      while (mask) {
+        expired.push_back(i + __builtin_ctz(mask));
+        mask &= mask - 1;
+      }
+    }
+#elif defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max_x = _mm_set1_ps(width);
+    const __m128 max_y = _mm_set1_ps(height);
+    for (; i + 4 <= count; i += 4) {
+      const __m128 x = _mm_loadu_ps(&position_x[i]);
+      const __m128 y = _mm_loadu_ps(&position_y[i]);
+      __m128 dead = _mm_cmple_ps(_mm_loadu_ps(&lifetime[i]), zero);
+      dead = _mm_or_ps(dead, _mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpge_ps(x, max_x)));
+      dead = _mm_or_ps(dead, _mm_or_ps(_mm_cmplt_ps(y, zero), _mm_cmpge_ps(y, max_y)));
+
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(dead));
+      while (mask) {
+        expired.push_back(i + __builtin_ctz(mask));
+        mask &= mask - 1;
+      }
+    }
+#endif
+
+    for (; i < count; i++) {
+      if (lifetime[i] <= 0.0f || position_x[i] < 0.0f || position_x[i] >= width || position_y[i] < 0.0f || position_y[i] >= height)
+        expired.push_back(i);
+    }
+
+    // Back to front, so the bullet swapped into a hole is always
+    // one that has already been checked and is alive
+    for (auto slot = expired.rbegin(); slot != expired.rend(); slot++)
+      swap_remove(*slot);
+  }
+
+private:
+  std::vector<uint32_t> expired;
+
+  void swap_remove(uint32_t slot) {
+    position_x[slot] = position_x.back();
+    position_y[slot] = position_y.back();
+    velocity_x[slot] = velocity_x.back();
+    velocity_y[slot] = velocity_y.back();
+    lifetime[slot] = lifetime.back();
+    damage[slot] = damage.back();
+    is_friendly[slot] = is_friendly.back();
+
+    position_x.pop_back();
+    position_y.pop_back();
+    velocity_x.pop_back();
+    velocity_y.pop_back();
+    lifetime.pop_back();
+    damage.pop_back();
+    is_friendly.pop_back();
+  }
+};
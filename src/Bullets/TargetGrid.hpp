@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Uniform grid over the few things bullets can hit, rebuilt
+// each tick. Each target is bucketed into every cell its box
+// (grown by the bullet size) touches, so a bullet only has to
+// look in the one cell its top-left corner is in, and most
+// bullets find an empty cell and are done.
+//
+// Cells are stored flat: cell_start[c]..cell_start[c + 1] is
+// the run of targets in cell c.
+///////////////////////////////////////////////////////////////
+class TargetGrid {
+public:
+  const static int32_t NO_TARGET = -1;
+
+  // margin is the bullet size, a bullet whose corner is up to that
+  // far above/left of a target can still overlap it
+  void reset(float width, float height, float margin, float new_cell_size = 128.0f) {
+    cell_size = new_cell_size;
+    bullet_margin = margin;
+    columns = std::max(1, static_cast<int32_t>(width / cell_size) + 1);
+    rows = std::max(1, static_cast<int32_t>(height / cell_size) + 1);
+
+    min_x.clear();
+    min_y.clear();
+    max_x.clear();
+    max_y.clear();
+    hit_by_friendly.clear();
+    target_index.clear();
+  }
+
+  void add(uint32_t target, float x0, float y0, float x1, float y1, bool friendly_hits) {
+    min_x.push_back(x0);
+    min_y.push_back(y0);
+    max_x.push_back(x1);
+    max_y.push_back(y1);
+    hit_by_friendly.push_back(friendly_hits ? 1 : 0);
+    target_index.push_back(target);
+  }
+
+  void build() {
+    cell_start.assign(columns * rows + 1, 0);
+
+    // Count, prefix sum, then fill, back to front so each cell's run
+    // ends up in the order the targets were added
+    for (uint32_t t = 0; t < target_index.size(); t++)
+      for_each_cell(t, [this](int32_t cell) { cell_start[cell + 1]++; });
+
+    for (uint32_t c = 0; c < cell_start.size() - 1; c++)
+      cell_start[c + 1] += cell_start[c];
+
+    cell_targets.resize(cell_start.back());
+    cell_fill.assign(cell_start.begin() + 1, cell_start.end());
+
+    for (uint32_t t = static_cast<uint32_t>(target_index.size()); t-- > 0;)
+      for_each_cell(t, [this, t](int32_t cell) { cell_targets[--cell_fill[cell]] = t; });
+  }
+
+  // First target overlapping the bullet box that this side of bullet
+  // damages, or NO_TARGET
+  int32_t query(float x, float y, float size, bool friendly) const {
+    const int32_t column = static_cast<int32_t>(x / cell_size);
+    const int32_t row = static_cast<int32_t>(y / cell_size);
+    if (column < 0 || row < 0 || column >= columns || row >= rows)
+      return NO_TARGET;
+
+    const int32_t cell = row * columns + column;
+    for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+      const uint32_t t = cell_targets[i];
+      if (hit_by_friendly[t] != (friendly ? 1 : 0))
+        continue;
+
+      if (x < max_x[t] && x + size > min_x[t] && y < max_y[t] && y + size > min_y[t])
+        return static_cast<int32_t>(target_index[t]);
+    }
+    return NO_TARGET;
+  }
+
+private:
+  float cell_size = 128.0f;
+  float bullet_margin = 0.0f;
+  int32_t columns = 1;
+  int32_t rows = 1;
+
+  std::vector<float> min_x;
+  std::vector<float> min_y;
+  std::vector<float> max_x;
+  std::vector<float> max_y;
+  std::vector<uint8_t> hit_by_friendly;
+  std::vector<uint32_t> target_index;
+
+  std::vector<uint32_t> cell_start;
+  std::vector<uint32_t> cell_fill;
+  std::vector<uint32_t> cell_targets;
+
+  template <typename T_func>
+  void for_each_cell(uint32_t t, T_func&& func) const {
+    const int32_t first_column = std::max(0, static_cast<int32_t>((min_x[t] - bullet_margin) / cell_size));
+    const int32_t first_row = std::max(0, static_cast<int32_t>((min_y[t] - bullet_margin) / cell_size));
+    const int32_t last_column = std::min(columns - 1, static_cast<int32_t>(max_x[t] / cell_size));
+    const int32_t last_row = std::min(rows - 1, static_cast<int32_t>(max_y[t] / cell_size));
+
+    for (int32_t row = first_row; row <= last_row; row++)
+      for (int32_t column = first_column; column <= last_column; column++)
+        func(row * columns + column);
+  }
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "./ColliderBounds.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////
+// Overlap kernel: tests one box against a contiguous run of
+// candidates in the SoA bounds and writes the overlapping
+// slot pairs out. Uses AVX (8 boxes) or SSE (4 boxes) when the
+// compiler targets them, the leftover tail is done scalar.
+//
+// The comparisons are strict, touching edges are not a hit.
+///////////////////////////////////////////////////////////////
+struct CollisionPair {
+  uint32_t lhs;
+  uint32_t rhs;
+};
+
+namespace AABBKernel {
+
+#if defined(__AVX__)
+const uint32_t LANES = 8;
+#elif defined(__SSE2__)
+const uint32_t LANES = 4;
+#else
+const uint32_t LANES = 1;
+#endif
+
+inline void test_scalar(const ColliderBounds& bounds, uint32_t box, uint32_t begin, uint32_t end, std::vector<CollisionPair>& pairs) {
+  const float min_x = bounds.min_x[box];
+  const float min_y = bounds.min_y[box];
+  const float max_x = bounds.max_x[box];
+  const float max_y = bounds.max_y[box];
+
+  for (uint32_t i = begin; i < end; i++) {
+    if (min_x < bounds.max_x[i] && max_x > bounds.min_x[i] &&
+        min_y < bounds.max_y[i] && max_y > bounds.min_y[i])
+      pairs.push_back({box, i});
+  }
+}
+
+inline void test(const ColliderBounds& bounds, uint32_t box, uint32_t begin, uint32_t end, std::vector<CollisionPair>& pairs) {
+  uint32_t i = begin;
+
+#if defined(__AVX__)
+  const __m256 min_x = _mm256_set1_ps(bounds.min_x[box]);
+  const __m256 min_y = _mm256_set1_ps(bounds.min_y[box]);
+  const __m256 max_x = _mm256_set1_ps(bounds.max_x[box]);
+  const __m256 max_y = _mm256_set1_ps(bounds.max_y[box]);
+
+  for (; i + LANES <= end; i += LANES) {
+    __m256 hit = _mm256_and_ps(
+      _mm256_cmp_ps(min_x, _mm256_loadu_ps(&bounds.max_x[i]), _CMP_LT_OQ),
+      _mm256_cmp_ps(max_x, _mm256_loadu_ps(&bounds.min_x[i]), _CMP_GT_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(min_y, _mm256_loadu_ps(&bounds.max_y[i]), _CMP_LT_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(max_y, _mm256_loadu_ps(&bounds.min_y[i]), _CMP_GT_OQ));
+
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(hit));
+    while (mask) {
+      pairs.push_back({box, i + __builtin_ctz(mask)});
+      mask &= mask - 1;
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128 min_x = _mm_set1_ps(bounds.min_x[box]);
+  const __m128 min_y = _mm_set1_ps(bounds.min_y[box]);
+  const __m128 max_x = _mm_set1_ps(bounds.max_x[box]);
+  const __m128 max_y = _mm_set1_ps(bounds.max_y[box]);
+
+  for (; i + LANES <= end; i += LANES) {
+    __m128 hit = _mm_and_ps(
+      _mm_cmplt_ps(min_x, _mm_loadu_ps(&bounds.max_x[i])),
+      _mm_cmpgt_ps(max_x, _mm_loadu_ps(&bounds.min_x[i])));
+    hit = _mm_and_ps(hit, _mm_cmplt_ps(min_y, _mm_loadu_ps(&bounds.max_y[i])));
+    hit = _mm_and_ps(hit, _mm_cmpgt_ps(max_y, _mm_loadu_ps(&bounds.min_y[i])));
+
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(hit));
+    while (mask) {
+      pairs.push_back({box, i + __builtin_ctz(mask)});
+      mask &= mask - 1;
+    }
+  }
+#endif
+
+  test_scalar(bounds, box, i, end, pairs);
+}
+
+// Brute force broadphase, every box against every later box
+inline void all_pairs(const ColliderBounds& bounds, std::vector<CollisionPair>& pairs) {
+  for (uint32_t i = 0; i < bounds.size(); i++)
+    test(bounds, i, i + 1, bounds.size(), pairs);
+}
+
+// Sweep and prune broadphase. Bounds must be sorted by min_x, so the
+// candidates for a box are the run of later boxes starting before its
+// max_x, which is a contiguous range the kernel can stream through
+inline void sweep_and_prune(const ColliderBounds& bounds, std::vector<CollisionPair>& pairs, uint32_t begin, uint32_t end) {
+  for (uint32_t i = begin; i < end; i++) {
+    auto run_end = std::lower_bound(bounds.min_x.begin() + i + 1, bounds.min_x.end(), bounds.max_x[i]);
+    test(bounds, i, i + 1, static_cast<uint32_t>(run_end - bounds.min_x.begin()), pairs);
+  }
+}
+
+inline void sweep_and_prune(const ColliderBounds& bounds, std::vector<CollisionPair>& pairs) {
+  sweep_and_prune(bounds, pairs, 0, bounds.size());
+}
+
+}
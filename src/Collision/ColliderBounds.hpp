@@ -0,0 +1,99 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// World-space bounds of every collider for the current frame,
+// stored as a struct of arrays so the overlap kernel can load
+// 4/8 boxes per register instead of chasing components.
+//
+// index[] maps each slot back to the entity's position in the
+// CollisionSystem entity vector.
+//
+// Fast movers are stored swept: the box covers where they were
+// at the start of the frame and where they are now, and the
+// displacement is kept so the time of impact can be solved.
+///////////////////////////////////////////////////////////////
+struct ColliderBounds {
+  std::vector<float> min_x;
+  std::vector<float> min_y;
+  std::vector<float> max_x;
+  std::vector<float> max_y;
+  std::vector<float> displacement_x;
+  std::vector<float> displacement_y;
+  std::vector<uint32_t> index;
+
+  uint32_t size() const { return static_cast<uint32_t>(index.size()); }
+
+  void clear() {
+    min_x.clear();
+    min_y.clear();
+    max_x.clear();
+    max_y.clear();
+    displacement_x.clear();
+    displacement_y.clear();
+    index.clear();
+  }
+
+  void reserve(uint32_t capacity) {
+    min_x.reserve(capacity);
+    min_y.reserve(capacity);
+    max_x.reserve(capacity);
+    max_y.reserve(capacity);
+    displacement_x.reserve(capacity);
+    displacement_y.reserve(capacity);
+    index.reserve(capacity);
+  }
+
+  void add(uint32_t entity_index, float x, float y, float width, float height) {
+    add_swept(entity_index, x, y, width, height, 0.0f, 0.0f);
+  }
+
+  // x and y are the position at the end of the frame, after moving
+  // by (dx, dy)
+  void add_swept(uint32_t entity_index, float x, float y, float width, float height, float dx, float dy) {
+    min_x.push_back(x - std::max(dx, 0.0f));
+    min_y.push_back(y - std::max(dy, 0.0f));
+    max_x.push_back(x + width - std::min(dx, 0.0f));
+    max_y.push_back(y + height - std::min(dy, 0.0f));
+    displacement_x.push_back(dx);
+    displacement_y.push_back(dy);
+    index.push_back(entity_index);
+  }
+
+  bool is_swept(uint32_t slot) const { return displacement_x[slot] != 0.0f || displacement_y[slot] != 0.0f; }
+
+  // Sweep and prune needs the boxes ordered along x. Ties are broken
+  // by entity index so the order (and the pairs found) is deterministic
+  void sort_by_min_x() {
+    permutation.resize(size());
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::sort(permutation.begin(), permutation.end(), [this](uint32_t lhs, uint32_t rhs) {
+      if (min_x[lhs] != min_x[rhs]) return min_x[lhs] < min_x[rhs];
+      return index[lhs] < index[rhs];
+    });
+
+    apply_permutation(min_x, scratch_float);
+    apply_permutation(min_y, scratch_float);
+    apply_permutation(max_x, scratch_float);
+    apply_permutation(max_y, scratch_float);
+    apply_permutation(displacement_x, scratch_float);
+    apply_permutation(displacement_y, scratch_float);
+    apply_permutation(index, scratch_index);
+  }
+
+private:
+  std::vector<uint32_t> permutation;
+  std::vector<float> scratch_float;
+  std::vector<uint32_t> scratch_index;
+
+  template <typename T>
+  void apply_permutation(std::vector<T>& values, std::vector<T>& scratch) {
+    scratch.resize(values.size());
+    for (uint32_t i = 0; i < permutation.size(); i++)
+      scratch[i] = values[permutation[i]];
+    values.swap(scratch);
+  }
+};
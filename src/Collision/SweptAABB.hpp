@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "./ColliderBounds.hpp"
+
+///////////////////////////////////////////////////////////////
+// Swept AABB test for the candidate pairs of fast movers.
+// Works in the frame of the rhs box, so only the relative
+// displacement matters and two moving boxes are handled the
+// same way as one moving box against a static one.
+//
+// Returns the time of impact in [0, 1) over the frame, or a
+// negative number if the boxes never overlap during it.
+///////////////////////////////////////////////////////////////
+namespace SweptAABB {
+
+const float NO_HIT = -1.0f;
+
+// Entry/exit times of the moving interval [a_min, a_max] against [b_min, b_max]
+inline bool slab(float a_min, float a_max, float b_min, float b_max, float d, float& t_enter, float& t_exit) {
+  if (d == 0.0f) {
+    if (a_min < b_max && a_max > b_min) {
+      t_enter = -std::numeric_limits<float>::infinity();
+      t_exit = std::numeric_limits<float>::infinity();
+      return true;
+    }
+    return false;
+  }
+
+  const float t1 = (b_min - a_max) / d;
+  const float t2 = (b_max - a_min) / d;
+  t_enter = std::min(t1, t2);
+  t_exit = std::max(t1, t2);
+  return true;
+}
+
+inline float time_of_impact(const ColliderBounds& bounds, uint32_t lhs, uint32_t rhs) {
+  const float lhs_dx = bounds.displacement_x[lhs];
+  const float lhs_dy = bounds.displacement_y[lhs];
+  const float rhs_dx = bounds.displacement_x[rhs];
+  const float rhs_dy = bounds.displacement_y[rhs];
+
+  // Undo the sweep to get both boxes as they were at the start of the frame
+  const float lhs_x = bounds.min_x[lhs] + std::max(lhs_dx, 0.0f) - lhs_dx;
+  const float lhs_y = bounds.min_y[lhs] + std::max(lhs_dy, 0.0f) - lhs_dy;
+  const float lhs_w = bounds.max_x[lhs] - bounds.min_x[lhs] - std::fabs(lhs_dx);
+  const float lhs_h = bounds.max_y[lhs] - bounds.min_y[lhs] - std::fabs(lhs_dy);
+
+  const float rhs_x = bounds.min_x[rhs] + std::max(rhs_dx, 0.0f) - rhs_dx;
+  const float rhs_y = bounds.min_y[rhs] + std::max(rhs_dy, 0.0f) - rhs_dy;
+  const float rhs_w = bounds.max_x[rhs] - bounds.min_x[rhs] - std::fabs(rhs_dx);
+  const float rhs_h = bounds.max_y[rhs] - bounds.min_y[rhs] - std::fabs(rhs_dy);
+
+  float enter_x, exit_x, enter_y, exit_y;
+  if (!slab(lhs_x, lhs_x + lhs_w, rhs_x, rhs_x + rhs_w, lhs_dx - rhs_dx, enter_x, exit_x)) return NO_HIT;
+  if (!slab(lhs_y, lhs_y + lhs_h, rhs_y, rhs_y + rhs_h, lhs_dy - rhs_dy, enter_y, exit_y)) return NO_HIT;
+
+  const float t_enter = std::max(enter_x, enter_y);
+  const float t_exit = std::min(exit_x, exit_y);
+
+  if (t_enter >= t_exit || t_enter >= 1.0f || t_exit <= 0.0f)
+    return NO_HIT;
+
+  return std::max(t_enter, 0.0f);
+}
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "../Tilemap/TilemapFile.hpp"
+
+///////////////////////////////////////////////////////////////
+// Box against the static collision layer of a tilemap, without
+// any per-tile colliders.
+//
+// The box is rasterized to the range of cells it covers. Each
+// chunk keeps one 64-bit word per row of tiles (bit n = column
+// n is solid), so the columns of the range inside a chunk turn
+// into one mask and a whole row of cells is tested with a
+// single AND. A ship sized box touches one or two chunks and a
+// couple of words.
+//
+// The same walk gives the extent of the solid cells under a box,
+// which is what pushing the box back out of them needs.
+///////////////////////////////////////////////////////////////
+namespace TileCollision {
+
+// Bits lo..hi (inclusive) set
+inline uint64_t column_mask(uint32_t lo, uint32_t hi) {
+  return (~uint64_t(0) >> (63 - hi)) & (~uint64_t(0) << lo);
+}
+
+// Cells a box covers, clamped to the map. Empty if the box is off the map
+struct CellRange {
+  int32_t first_column;
+  int32_t last_column;
+  int32_t first_row;
+  int32_t last_row;
+
+  bool is_empty() const { return first_column > last_column || first_row > last_row; }
+};
+
+inline CellRange cell_range(const TilemapFileHeader& header, float tile_world_size, float min_x, float min_y, float max_x, float max_y) {
+  if (max_x <= 0.0f || max_y <= 0.0f || min_x >= header.columns * tile_world_size || min_y >= header.rows * tile_world_size)
+    return {0, -1, 0, -1};
+
+  return {
+    std::max(0, static_cast<int32_t>(std::floor(min_x / tile_world_size))),
+    std::min<int32_t>(header.columns - 1, static_cast<int32_t>(std::ceil(max_x / tile_world_size)) - 1),
+    std::max(0, static_cast<int32_t>(std::floor(min_y / tile_world_size))),
+    std::min<int32_t>(header.rows - 1, static_cast<int32_t>(std::ceil(max_y / tile_world_size)) - 1)
+  };
+}
+
+// Calls func(row, column_offset, bits) for each row of each chunk the range
+// covers, bits being the solid columns of the range in that row (bit n =
+// column column_offset + n). Stops early when func returns false
+template <typename T_func>
+inline void for_each_solid_row(const TilemapFile& file, const CellRange& range, T_func&& func) {
+  const int32_t chunk_tiles = file.get_header().chunk_tiles;
+
+  for (int32_t chunk_row = range.first_row / chunk_tiles; chunk_row <= range.last_row / chunk_tiles; chunk_row++) {
+    const int32_t chunk_y = chunk_row * chunk_tiles;
+    const int32_t row_begin = std::max(range.first_row, chunk_y) - chunk_y;
+    const int32_t row_end = std::min(range.last_row, chunk_y + chunk_tiles - 1) - chunk_y;
+
+    for (int32_t chunk_column = range.first_column / chunk_tiles; chunk_column <= range.last_column / chunk_tiles; chunk_column++) {
+      const uint64_t* collision = file.get_chunk_collision(chunk_column, chunk_row);
+      if (!collision) continue;
+
+      // The columns of the range that fall inside this chunk
+      const int32_t chunk_x = chunk_column * chunk_tiles;
+      const uint64_t mask = column_mask(
+        std::max(range.first_column, chunk_x) - chunk_x,
+        std::min(range.last_column, chunk_x + chunk_tiles - 1) - chunk_x
+      );
+
+      for (int32_t row = row_begin; row <= row_end; row++) {
+        const uint64_t bits = collision[row] & mask;
+        if (bits && !func(chunk_y + row, chunk_x, bits)) return;
+      }
+    }
+  }
+}
+
+// Box in world pixels, max edges exclusive
+inline bool overlaps_solid(const TilemapFile& file, float tile_world_size, float min_x, float min_y, float max_x, float max_y) {
+  if (!file.is_open() || !file.has_collision()) return false;
+
+  const CellRange range = cell_range(file.get_header(), tile_world_size, min_x, min_y, max_x, max_y);
+  if (range.is_empty()) return false;
+
+  bool overlaps = false;
+  for_each_solid_row(file, range, [&](int32_t, int32_t, uint64_t) {
+    overlaps = true;
+    return false;
+  });
+  return overlaps;
+}
+
+// Shortest move along one axis that takes the box clear of every solid
+// cell it overlaps, written to (dx, dy). Returns false (and no move) if it
+// doesn't overlap any. Moving out may land the box on other solid cells,
+// the next frame's contact pushes it again
+inline bool separation(const TilemapFile& file, float tile_world_size, float min_x, float min_y, float max_x, float max_y, float& dx, float& dy) {
+  dx = 0.0f;
+  dy = 0.0f;
+  if (!file.is_open() || !file.has_collision()) return false;
+
+  const CellRange range = cell_range(file.get_header(), tile_world_size, min_x, min_y, max_x, max_y);
+  if (range.is_empty()) return false;
+
+  // Extent of the solid cells under the box
+  int32_t solid_first_column = range.last_column + 1;
+  int32_t solid_last_column = range.first_column - 1;
+  int32_t solid_first_row = range.last_row + 1;
+  int32_t solid_last_row = range.first_row - 1;
+
+  for_each_solid_row(file, range, [&](int32_t row, int32_t column_offset, uint64_t bits) {
+    solid_first_column = std::min(solid_first_column, column_offset + __builtin_ctzll(bits));
+    solid_last_column = std::max(solid_last_column, column_offset + 63 - __builtin_clzll(bits));
+    solid_first_row = std::min(solid_first_row, row);
+    solid_last_row = std::max(solid_last_row, row);
+    return true;
+  });
+  if (solid_first_row > solid_last_row) return false;
+
+  const float left = max_x - solid_first_column * tile_world_size;
+  const float right = (solid_last_column + 1) * tile_world_size - min_x;
+  const float up = max_y - solid_first_row * tile_world_size;
+  const float down = (solid_last_row + 1) * tile_world_size - min_y;
+
+  const float x = (left < right) ? -left : right;
+  const float y = (up < down) ? -up : down;
+  if (std::abs(x) < std::abs(y))
+    dx = x;
+  else
+    dy = y;
+  return true;
+}
+
+}
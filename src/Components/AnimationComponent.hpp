@@ -1,6 +1,5 @@
 #pragma once
-#include <SDL2/SDL.h>
-#include <SDL2/SDL_timer.h>
+#include <cstdint>
 
 struct AnimationComponent {
   uint16_t num_of_frames;
@@ -9,7 +8,8 @@ struct AnimationComponent {
   bool is_loop;
   uint32_t start_time;
 
-  AnimationComponent(uint8_t num_of_frames = 1, uint16_t frame_speed = 1, bool is_loop = true) 
-  : num_of_frames{num_of_frames}, current_frame{1}, frame_speed{frame_speed}, is_loop{is_loop}, start_time{SDL_GetTicks()}
+  // start_time is simulation clock ticks (registry->get_clock().get_ticks())
+  AnimationComponent(uint8_t num_of_frames = 1, uint16_t frame_speed = 1, bool is_loop = true, uint32_t start_time = 0) 
+  : num_of_frames{num_of_frames}, current_frame{1}, frame_speed{frame_speed}, is_loop{is_loop}, start_time{start_time}
   {}
 };
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+// Fires rings of bullet-hell bullets instead of projectile entities.
+// Each burst is num_of_bullets evenly spread around the emitter, turned
+// by spin degrees from the last one so repeated bursts spiral
+struct BulletPatternComponent {
+  uint16_t num_of_bullets;
+  float bullet_speed;
+  uint32_t repeat_speed;
+  uint16_t bullet_duration;
+  uint16_t damage;
+  bool is_friendly;
+  float spin;
+  float angle;
+  uint32_t last_emission_time;
+
+  // last_emission_time is simulation clock ticks (registry->get_clock().get_ticks())
+  BulletPatternComponent(uint16_t num_of_bullets = 32, float bullet_speed = 200, uint32_t repeat_speed = 250,
+                         uint16_t bullet_duration = 5000, uint16_t damage = 1, bool is_friendly = false,
+                         float spin = 7.5f, uint32_t last_emission_time = 0)
+                         : num_of_bullets(num_of_bullets), bullet_speed(bullet_speed), repeat_speed(repeat_speed),
+                         bullet_duration(bullet_duration), damage(damage), is_friendly(is_friendly), spin(spin),
+                         angle(0.0f), last_emission_time(last_emission_time) {}
+};
@@ -1,6 +1,8 @@
 #pragma once
+#include <cstdint>
 
 struct CollisionComponent {
   bool is_colliding;
-  CollisionComponent(bool is_colliding = false ) : is_colliding(is_colliding) {}
+  uint16_t num_of_contacts;
+  CollisionComponent(bool is_colliding = false ) : is_colliding(is_colliding), num_of_contacts{0} {}
 };
@@ -1,5 +1,4 @@
 #pragma once
-#include <SDL2/SDL_timer.h>
 #include <cstdint>
 
 struct ProjectileComponent {
@@ -8,6 +7,7 @@ struct ProjectileComponent {
   uint16_t duration;
   uint32_t start_time;
 
-  ProjectileComponent(bool is_friendly = false, uint16_t damage = 0, uint16_t duration = 0) 
-  : is_friendly(is_friendly), damage(damage), duration(duration), start_time(SDL_GetTicks()) {}
+  // start_time is simulation clock ticks (registry->get_clock().get_ticks())
+  ProjectileComponent(bool is_friendly = false, uint16_t damage = 0, uint16_t duration = 0, uint32_t start_time = 0) 
+  : is_friendly(is_friendly), damage(damage), duration(duration), start_time(start_time) {}
 };
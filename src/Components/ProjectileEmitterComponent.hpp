@@ -1,6 +1,6 @@
 #pragma once
 #include "../../libs/glm/glm.hpp"
-#include <SDL2/SDL.h>
+#include <cstdint>
 
 struct ProjectileEmitterComponent {
   glm::vec2 projectile_velocity;
@@ -10,9 +10,10 @@ struct ProjectileEmitterComponent {
   bool is_friendly;
   uint32_t last_emission_time;
 
+  // last_emission_time is simulation clock ticks (registry->get_clock().get_ticks())
   ProjectileEmitterComponent(glm::vec2 projectile_velocity = glm::vec2(0, 0), uint32_t repeat_speed = 0, 
                           uint16_t projectile_duration = 10000, uint16_t damage = 10, 
-                          bool is_friendly = false) 
+                          bool is_friendly = false, uint32_t last_emission_time = 0) 
                           : projectile_velocity(projectile_velocity), repeat_speed(repeat_speed), projectile_duration(projectile_duration),
-                          damage(damage), is_friendly(is_friendly), last_emission_time(SDL_GetTicks()) {}
+                          damage(damage), is_friendly(is_friendly), last_emission_time(last_emission_time) {}
 };
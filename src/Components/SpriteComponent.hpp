@@ -1,17 +1,23 @@
 #pragma once
 #include <cstdint>
-#include <string>
+#include <type_traits>
 #include <SDL2/SDL.h>
+#include "../AssetManager/AssetHandle.hpp"
 
 struct SpriteComponent {
-  std::string asset_id;
+  SDL_Rect src_rect;
+  TextureHandle texture;
   uint16_t width;
   uint16_t height;
-  SDL_Rect src_rect;
   int8_t z_index;
   bool is_fixed;
   SDL_RendererFlip flip;
 
-  SpriteComponent(std::string asset_id = "", uint16_t width = 0, uint16_t height = 0, uint16_t src_rect_x = 0, int16_t src_rect_y = 0, int8_t z_index = 0, bool is_fixed = false)
-    : asset_id(asset_id), width{width}, height{height}, src_rect{src_rect_x, src_rect_y, width, height}, z_index{z_index}, is_fixed{is_fixed}, flip{SDL_FLIP_NONE} {}
+  // The asset id is turned into a handle here, once
+  SpriteComponent(TextureHandle texture = TextureHandle(), uint16_t width = 0, uint16_t height = 0, uint16_t src_rect_x = 0, int16_t src_rect_y = 0, int8_t z_index = 0, bool is_fixed = false)
+    : src_rect{src_rect_x, src_rect_y, width, height}, texture{texture}, width{width}, height{height}, z_index{z_index}, is_fixed{is_fixed}, flip{SDL_FLIP_NONE} {}
 };
+
+// Pools copy sprites around, keep them plain data
+static_assert(std::is_trivially_copyable<SpriteComponent>::value, "SpriteComponent must stay trivially copyable");
+static_assert(sizeof(SpriteComponent) <= 32, "SpriteComponent grew, check the field order");
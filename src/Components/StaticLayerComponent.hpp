@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+// Static layers, drawn back to front before any other sprite. Layers
+// below STATIC_LAYER_DECORATION go under the tilemap, the rest over it
+const uint8_t STATIC_LAYER_BACKGROUND = 0;
+const uint8_t STATIC_LAYER_DECORATION = 1;
+const uint8_t MAX_STATIC_LAYERS = 4;
+
+// The sprite is drawn from a cached layer (see RenderLayerSystem)
+// instead of by RenderSystem every frame
+struct StaticLayerComponent {
+  uint8_t layer;
+  StaticLayerComponent(uint8_t layer = STATIC_LAYER_BACKGROUND) : layer{layer} {}
+};
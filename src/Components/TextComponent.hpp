@@ -2,14 +2,17 @@
 #include "../../libs/glm/glm.hpp"
 #include <SDL2/SDL_pixels.h>
 #include <string>
+#include "../AssetManager/AssetHandle.hpp"
 
 struct TextComponent {
   bool is_fixed;
   glm::vec2 position;
   std::string text;
-  std::string asset_id;
+  FontHandle font;
   SDL_Color color;
+  // Changes most frames (fps, score), drawn from a glyph atlas instead of cached whole
+  bool is_dynamic;
 
-  TextComponent(bool is_fixed = true, glm::vec2 position = glm::vec2(0, 0), std::string text = "", std::string asset_id = "", const SDL_Color& color = {0, 0, 0})
-                : is_fixed {is_fixed}, position {position}, text {text}, asset_id {asset_id}, color {color} {}
+  TextComponent(bool is_fixed = true, glm::vec2 position = glm::vec2(0, 0), std::string text = "", FontHandle font = FontHandle(), const SDL_Color& color = {0, 0, 0}, bool is_dynamic = false)
+                : is_fixed {is_fixed}, position {position}, text {text}, font {font}, color {color}, is_dynamic {is_dynamic} {}
 };
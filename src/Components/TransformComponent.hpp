@@ -5,8 +5,13 @@ struct TransformComponent {
   glm::vec2 position;
   glm::vec2 scale;
   float rotation;
+  // Position at the start of the current simulation tick, rendering
+  // blends between the two so it's smooth at any refresh rate
+  glm::vec2 previous_position;
 
   TransformComponent(glm::vec2 pos = glm::vec2(0, 0), glm::vec2 scale = glm::vec2(1, 1), float rot = 0.0) 
-    : position{pos}, scale{scale}, rotation{rot} {
+    : position{pos}, scale{scale}, rotation{rot}, previous_position{pos} {
   }
+
+  glm::vec2 interpolated_position(float alpha) const { return previous_position + (position - previous_position) * alpha; }
 };
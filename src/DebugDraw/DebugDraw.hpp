@@ -0,0 +1,154 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../Logger/Logger.hpp"
+
+///////////////////////////////////////////////////////////////
+// Immediate mode buffer for overlays (health bars, collider
+// boxes...). Systems queue shapes during the frame and flush()
+// draws them all at once, so each colour costs one draw colour
+// change and one SDL_RenderFillRects/DrawRects call, instead of
+// a colour change and a call per shape.
+//
+// Quads carry their colour per vertex, all of them go out in a
+// single SDL_RenderGeometry call. Without RenderGeometry (SDL
+// older than 2.0.18, or the renderer refused it) their outline
+// is drawn instead.
+//
+// Within a flush: quads, then filled rects, then outlines, then
+// lines, so outlines always end up on top of fills.
+///////////////////////////////////////////////////////////////
+class DebugDraw {
+public:
+  void fill_rect(const SDL_Rect& rect, SDL_Color color) { get_batch(color).fill_rects.push_back(rect); }
+  void draw_rect(const SDL_Rect& rect, SDL_Color color) { get_batch(color).outline_rects.push_back(rect); }
+
+  void draw_line(int x0, int y0, int x1, int y1, SDL_Color color) {
+    auto& lines = get_batch(color).lines;
+    lines.push_back({x0, y0});
+    lines.push_back({x1, y1});
+  }
+
+  // Corners in winding order, either way round
+  void fill_quad(const SDL_FPoint corners[4], SDL_Color color) {
+    for (uint32_t corner = 0; corner < 4; corner++)
+      quad_corners.push_back({corners[corner], color});
+  }
+
+  void flush(SDL_Renderer* renderer) {
+    SDL_BlendMode previous_blend_mode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend_mode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    flush_quads(renderer);
+
+    for (const auto& batch: batches) {
+      if (batch.fill_rects.empty()) continue;
+      set_color(renderer, batch.color);
+      SDL_RenderFillRects(renderer, batch.fill_rects.data(), static_cast<int>(batch.fill_rects.size()));
+    }
+    for (const auto& batch: batches) {
+      if (batch.outline_rects.empty()) continue;
+      set_color(renderer, batch.color);
+      SDL_RenderDrawRects(renderer, batch.outline_rects.data(), static_cast<int>(batch.outline_rects.size()));
+    }
+    for (const auto& batch: batches) {
+      if (batch.lines.empty()) continue;
+      set_color(renderer, batch.color);
+      for (size_t i = 0; i + 1 < batch.lines.size(); i += 2)
+        SDL_RenderDrawLine(renderer, batch.lines[i].x, batch.lines[i].y, batch.lines[i + 1].x, batch.lines[i + 1].y);
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend_mode);
+    clear();
+  }
+
+  // Drops whatever was queued, the batches keep their memory for the next frame
+  void clear() {
+    for (auto& batch: batches) {
+      batch.fill_rects.clear();
+      batch.outline_rects.clear();
+      batch.lines.clear();
+    }
+    quad_corners.clear();
+  }
+
+private:
+  struct ColorBatch {
+    SDL_Color color;
+    uint32_t key;
+    std::vector<SDL_Rect> fill_rects;
+    std::vector<SDL_Rect> outline_rects;
+    // Pairs of end points
+    std::vector<SDL_Point> lines;
+  };
+
+  struct QuadCorner {
+    SDL_FPoint position;
+    SDL_Color color;
+  };
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  bool use_geometry = true;
+#else
+  bool use_geometry = false;
+#endif
+
+  // Only a handful of colours are ever in use, a linear scan beats hashing
+  std::vector<ColorBatch> batches;
+  std::vector<QuadCorner> quad_corners;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<SDL_Vertex> vertices;
+#endif
+  std::vector<int> indices;
+
+  ColorBatch& get_batch(SDL_Color color) {
+    const uint32_t key = (uint32_t(color.r) << 24) | (uint32_t(color.g) << 16) | (uint32_t(color.b) << 8) | color.a;
+    for (auto& batch: batches)
+      if (batch.key == key) return batch;
+
+    batches.push_back(ColorBatch{color, key, {}, {}, {}});
+    return batches.back();
+  }
+
+  static void set_color(SDL_Renderer* renderer, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  }
+
+  void flush_quads(SDL_Renderer* renderer) {
+    if (quad_corners.empty()) return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (use_geometry) {
+      vertices.clear();
+      for (const auto& corner: quad_corners)
+        vertices.push_back({corner.position, corner.color, {0.0f, 0.0f}});
+
+      const uint32_t num_of_quads = static_cast<uint32_t>(quad_corners.size() / 4);
+      for (uint32_t quad = static_cast<uint32_t>(indices.size() / 6); quad < num_of_quads; quad++) {
+        const int first = static_cast<int>(quad * 4);
+        indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+      }
+
+      if (SDL_RenderGeometry(renderer, NULL, vertices.data(), static_cast<int>(vertices.size()),
+                             indices.data(), static_cast<int>(num_of_quads * 6)) == 0)
+        return;
+
+      Logger::Warn(std::string("SDL_RenderGeometry failed, debug quads fall back to outlines: ") + SDL_GetError());
+      use_geometry = false;
+    }
+#endif
+
+    for (size_t first = 0; first + 3 < quad_corners.size(); first += 4) {
+      SDL_Point outline[5];
+      for (uint32_t corner = 0; corner < 5; corner++) {
+        const SDL_FPoint& position = quad_corners[first + corner % 4].position;
+        outline[corner] = {static_cast<int>(position.x), static_cast<int>(position.y)};
+      }
+      set_color(renderer, quad_corners[first].color);
+      SDL_RenderDrawLines(renderer, outline, 5);
+    }
+  }
+};
@@ -1,12 +1,14 @@
 #include "ECS.hpp"
 #include "../Logger/Logger.hpp"
 #include <string>
+#include <algorithm>
 
 uint8_t I_component::next_id {0};
 
 uint32_t Entity::get_entity_id() const { return entity_id; }
 
 void Entity::remove() { registry->remove_entity(*this); }
+void Entity::release() { registry->release_entity(*this); }
 
 void Entity::tag(const std::string& tag) { registry->add_tag_to_entity(*this, tag); }
 bool Entity::has_tag(const std::string& tag) const { return registry->entity_has_tag(*this, tag); }
@@ -28,13 +30,19 @@ void System::remove_entity_from_system(Entity entity) {
 std::vector<Entity> System::get_system_entities() const { return entities; }
 const Signature& System::get_component_signature() const { return component_signature; }
 
+bool System::accepts(const Entity& entity) const {
+  return (entity.registry->get_entity_signature(entity) & component_signature) == component_signature;
+}
+
 Entity Registry::create_entity() {
   uint32_t entity_id;
 
   if (free_ids.empty()) {
     entity_id = total_num_of_entities++;
-    if (entity_id >= entity_component_signatures.size())
+    if (entity_id >= entity_component_signatures.size()) {
       entity_component_signatures.resize(entity_id + 1);
+      released_entities.resize(entity_id + 1, false);
+    }
   }
   else {
     entity_id = free_ids.front();
@@ -54,24 +62,71 @@ void Registry::remove_entity(Entity entity) {
   Logger::Warn("Removing Entity with ID [" + std::to_string(entity.get_entity_id()) + "]!");
 }
 
+void Registry::release_entity(Entity entity) {
+  const auto entity_id = entity.get_entity_id();
+  auto grouped_entity = group_per_entity.find(entity_id);
+
+  // Only grouped entities have a pool to go back to
+  if (grouped_entity == group_per_entity.end()) {
+    remove_entity(entity);
+    return;
+  }
+
+  // Several systems can let go of the same projectile in one frame
+  if (released_entities[entity_id] || entities_to_remove.find(entity) != entities_to_remove.end())
+    return;
+
+  released_entities[entity_id] = true;
+  entities_to_release.insert(entity);
+  entity_pools[grouped_entity->second].free_entities.push_back(entity);
+}
+
+std::optional<Entity> Registry::acquire_entity(const std::string& group) {
+  auto& pool = entity_pools[group];
+
+  if (pool.free_entities.empty()) {
+    pool.misses++;
+    return std::nullopt;
+  }
+
+  Entity entity = pool.free_entities.back();
+  pool.free_entities.pop_back();
+  pool.hits++;
+
+  // Rejoins the systems on the next update, after any pending release
+  released_entities[entity.get_entity_id()] = false;
+  entities_to_add.insert(entity);
+  return entity;
+}
+
+bool Registry::is_entity_released(const Entity& entity) const { return released_entities[entity.get_entity_id()]; }
+
+EntityPoolStats Registry::get_entity_pool_stats(const std::string& group) const {
+  EntityPoolStats stats;
+  auto pool = entity_pools.find(group);
+
+  if (pool != entity_pools.end()) {
+    stats.hits = pool->second.hits;
+    stats.misses = pool->second.misses;
+    stats.size = static_cast<uint32_t>(pool->second.free_entities.size());
+  }
+  return stats;
+}
+
 void Registry::remove_entity_from_system(Entity entity) {
   for (auto& system: systems)
     system.second->remove_entity_from_system(entity);
 }
 
 void Registry::add_entity_to_system(Entity entity) {
-  const auto& entity_id = entity.get_entity_id();
-  const auto& entity_component_signature = entity_component_signatures[entity_id];
-
   for (auto& sys: systems) {
-    const auto& system_component_signature = sys.second->get_component_signature();
-    bool will_accept = (entity_component_signature & system_component_signature) == system_component_signature;
-    
-    if (will_accept)
+    if (sys.second->accepts(entity))
       sys.second->add_entity_to_system(entity);
   }
 }
 
+const Signature& Registry::get_entity_signature(const Entity& entity) const { return entity_component_signatures[entity.get_entity_id()]; }
+
 void Registry::add_tag_to_entity(Entity& entity, const std::string& tag) {
   entity_per_tag.emplace(tag, entity);
   tag_per_entity.emplace(entity.get_entity_id(), tag);
@@ -105,7 +160,7 @@ void Registry::add_group_to_entity(Entity& entity, const std::string& group) {
 bool Registry::entity_in_group(const Entity& entity, const std::string& group) const {
   if (entities_per_group.find(group) == entities_per_group.end()) return false;
 
-  auto group_entities = entities_per_group.at(group);
+  const auto& group_entities = entities_per_group.at(group);
   return group_entities.find(entity.get_entity_id()) != group_entities.end();
 }
 
@@ -126,10 +181,20 @@ void Registry::remove_group_from_entity(Entity entity) {
       if (entity_in_group != group->second.end())
         group->second.erase(entity_in_group);
     }
+
+    // The id gets reused, so it mustn't keep pointing at the old group
+    group_per_entity.erase(grouped_entity);
   }
 }
 
 void Registry::update() {
+  // Releases go first, a projectile released and re-acquired in the
+  // same frame has to end up back in the systems
+  for (auto& entity: entities_to_release)
+    remove_entity_from_system(entity);
+
+  entities_to_release.clear();
+
   for (auto& entity: entities_to_add)
     add_entity_to_system(entity);
 
@@ -137,6 +202,14 @@ void Registry::update() {
 
   for (auto& entity: entities_to_remove) {
     remove_entity_from_system(entity);
+
+    // Don't leave a dead id sitting in a free list
+    if (released_entities[entity.get_entity_id()]) {
+      released_entities[entity.get_entity_id()] = false;
+      auto& free_entities = entity_pools[group_per_entity[entity.get_entity_id()]].free_entities;
+      free_entities.erase(std::remove(free_entities.begin(), free_entities.end(), entity), free_entities.end());
+    }
+
     entity_component_signatures[entity.get_entity_id()].reset();
 
     for (auto& pool: component_pool) {
@@ -10,7 +10,9 @@
 #include <vector>
 #include <set>
 #include <deque>
+#include <optional>
 #include "../Logger/Logger.hpp"
+#include "../SimulationClock/SimulationClock.hpp"
 
 ///////////////////////////////////////////////////////////////
 // bitset tracks which components an entity has, and helps
@@ -76,6 +78,7 @@ public:
 
   uint32_t get_entity_id() const;
   void remove();
+  void release();
 
   void tag(const std::string& tag);
   bool has_tag(const std::string& tag) const;
@@ -98,14 +101,23 @@ private:
 class System {
 public:
   System() = default;
-  ~System() = default;
+  virtual ~System() = default;
   System(const System&) = default;
   
-  void add_entity_to_system(Entity entity);
-  void remove_entity_from_system(Entity entity);
+  // Virtual so a system can keep per entity state in sync
+  // (e.g. CollisionSystem dropping cached contacts)
+  virtual void add_entity_to_system(Entity entity);
+  virtual void remove_entity_from_system(Entity entity);
   std::vector<Entity> get_system_entities() const;
   const Signature& get_component_signature() const;
   template<typename T_component> void require_component();
+  // Has every component the system requires, for systems that walk a list
+  // other than their own (e.g. the visible set)
+  bool accepts(const Entity& entity) const;
+
+protected:
+  // The list itself instead of a copy, only valid until entities join or leave
+  const std::vector<Entity>& get_entities() const { return entities; }
 
 private:
   Signature component_signature;
@@ -196,6 +208,18 @@ private:
   std::unordered_map<uint32_t, uint32_t> index_to_entity_id;
 };
 
+///////////////////////////////////////////////////////////////
+// Counters for the free list of a recycled group, a miss is an
+// acquire that found the list empty and had to create instead
+///////////////////////////////////////////////////////////////
+struct EntityPoolStats {
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t size = 0;
+
+  float hit_rate() const { return (hits + misses > 0) ? static_cast<float>(hits) / (hits + misses) : 0.0f; }
+};
+
 ///////////////////////////////////////////////////////////////
 // The registry can manipulate an entity and its components
 // it's what the game code will interact with to do things
@@ -215,6 +239,7 @@ public:
 
   void add_entity_to_system(Entity entity);
   void remove_entity_from_system(Entity entity);
+  const Signature& get_entity_signature(const Entity& entity) const;
 
   void add_tag_to_entity(Entity& entity, const std::string& tag);
   bool entity_has_tag(const Entity& entity, const std::string& tag) const;
@@ -226,6 +251,15 @@ public:
   std::vector<Entity> get_entities_by_group(const std::string& group) const;
   void remove_group_from_entity(Entity entity);
 
+  // Entity recycling
+  // Released entities leave every system but keep their id, group and
+  // components, so re-acquiring one is a few component writes instead
+  // of a create plus an add_component per component
+  void release_entity(Entity entity);
+  std::optional<Entity> acquire_entity(const std::string& group);
+  bool is_entity_released(const Entity& entity) const;
+  EntityPoolStats get_entity_pool_stats(const std::string& group) const;
+
   // Component management
   template <typename T_component, typename ...T_Args> void add_component(Entity entity, T_Args&& ...T_args);
   template <typename T_component> void remove_component(Entity entity);
@@ -238,9 +272,14 @@ public:
   template <typename T_system> bool has_system() const;
   template <typename T_system> T_system& get_system() const;
 
+  // Game time shared by every system, ticked once per simulation step
+  SimulationClock& get_clock() { return clock; }
+  const SimulationClock& get_clock() const { return clock; }
+
   void update();
 
 private:
+  SimulationClock clock;
   uint32_t total_num_of_entities {0};
   // Each pool contains all the data of a certain comp type
   // Vector index is component type ID
@@ -253,8 +292,19 @@ private:
   std::unordered_map<std::type_index, std::shared_ptr<System>> systems;
   std::set<Entity> entities_to_add;
   std::set<Entity> entities_to_remove;
+  std::set<Entity> entities_to_release;
   std::deque<uint32_t> free_ids;
 
+  // Vector index = entity id
+  std::vector<bool> released_entities;
+
+  struct EntityPool {
+    std::vector<Entity> free_entities;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+  };
+  std::unordered_map<std::string, EntityPool> entity_pools;
+
   std::unordered_map<std::string, Entity> entity_per_tag;
   std::unordered_map<uint16_t, std::string> tag_per_entity;
 
@@ -0,0 +1,14 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../EventManager/Event.hpp"
+
+// A bullet-hell bullet hit a target. Bullets aren't entities, so
+// this carries what DamageSystem would read off a ProjectileComponent
+class BulletHitEvent : public Event {
+public:
+  Entity target;
+  uint16_t damage;
+  bool is_friendly;
+  BulletHitEvent(Entity target, uint16_t damage, bool is_friendly) : target{target}, damage{damage}, is_friendly{is_friendly} {}
+  ~BulletHitEvent() = default;
+};
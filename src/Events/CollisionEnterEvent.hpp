@@ -0,0 +1,16 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../../libs/glm/glm.hpp"
+#include "./CollisionEvent.hpp"
+
+// First frame two boxes overlap. time_of_impact is the fraction of
+// the frame's movement where a swept projectile first touched (1 if
+// neither entity was swept). separation is the shortest move that
+// takes lhs back out of rhs
+class CollisionEnterEvent : public CollisionEvent {
+public:
+  float time_of_impact;
+  glm::vec2 separation;
+  CollisionEnterEvent(Entity lhs, Entity rhs, float time_of_impact = 1.0f, glm::vec2 separation = glm::vec2(0)) : CollisionEvent(lhs, rhs), time_of_impact{time_of_impact}, separation{separation} {}
+  ~CollisionEnterEvent() = default;
+};
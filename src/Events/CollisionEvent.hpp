@@ -2,6 +2,7 @@
 #include "../ECS/ECS.hpp"
 #include "../EventManager/Event.hpp"
 
+// Shared by CollisionEnterEvent, CollisionStayEvent and CollisionExitEvent
 class CollisionEvent : public Event {
 public:
   Entity lhs;
@@ -0,0 +1,10 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "./CollisionEvent.hpp"
+
+// First frame two boxes that were overlapping stopped overlapping
+class CollisionExitEvent : public CollisionEvent {
+public:
+  CollisionExitEvent(Entity lhs, Entity rhs) : CollisionEvent(lhs, rhs) {}
+  ~CollisionExitEvent() = default;
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../../libs/glm/glm.hpp"
+#include "./CollisionEvent.hpp"
+
+// Every following frame the two boxes are still overlapping,
+// separation is the shortest move that takes lhs out of rhs
+class CollisionStayEvent : public CollisionEvent {
+public:
+  glm::vec2 separation;
+  CollisionStayEvent(Entity lhs, Entity rhs, glm::vec2 separation = glm::vec2(0)) : CollisionEvent(lhs, rhs), separation{separation} {}
+  ~CollisionStayEvent() = default;
+};
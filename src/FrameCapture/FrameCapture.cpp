@@ -0,0 +1,54 @@
+#include "./FrameCapture.hpp"
+#include "../Logger/Logger.hpp"
+#include <cstdio>
+
+FrameCapture::FrameCapture() : run_hash{FNV_OFFSET_BASIS}, num_of_frames{0} {}
+
+uint64_t FrameCapture::hash_bytes(const uint8_t* bytes, size_t size, uint64_t hash) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+uint64_t FrameCapture::capture(SDL_Renderer* renderer, uint32_t frame) {
+  int width = 0;
+  int height = 0;
+  if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0 || width <= 0 || height <= 0)
+    return 0;
+
+  // Tightly packed, so the hash never sees row padding
+  const int pitch = width * 3;
+  pixels.resize(static_cast<size_t>(pitch) * height);
+  if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGB24, pixels.data(), pitch) != 0) {
+    Logger::Err(std::string("Failed reading back frame ") + std::to_string(frame) + ": " + SDL_GetError());
+    return 0;
+  }
+
+  const uint64_t frame_hash = hash_bytes(pixels.data(), pixels.size());
+  run_hash = hash_bytes(reinterpret_cast<const uint8_t*>(&frame_hash), sizeof(frame_hash), run_hash);
+  num_of_frames++;
+
+  if (!directory.empty()) {
+    char file_name[32];
+    std::snprintf(file_name, sizeof(file_name), "/frame_%05u.ppm", frame);
+    write_ppm(directory + file_name, width, height);
+  }
+  return frame_hash;
+}
+
+bool FrameCapture::write_ppm(const std::string& path, int width, int height) const {
+  FILE* file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    Logger::Err("Failed opening " + path + " for the frame capture");
+    return false;
+  }
+
+  std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+  const bool written = std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+  std::fclose(file);
+
+  if (!written) Logger::Err("Failed writing " + path);
+  return written;
+}
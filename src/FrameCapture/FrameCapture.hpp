@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+///////////////////////////////////////////////////////////////
+// Reads back what the renderer drew for headless runs, to tell
+// whether a change to rendering changed the picture.
+//
+// Each frame is hashed (64-bit FNV-1a over the RGB bytes) and
+// the per-frame hashes are folded into one for the whole run,
+// so two runs of the same scene can be compared from a single
+// line. With a directory set, frames are also written out as
+// binary PPMs (frame_00001.ppm...) to look at the difference.
+///////////////////////////////////////////////////////////////
+class FrameCapture {
+public:
+  FrameCapture();
+  ~FrameCapture() = default;
+
+  // Empty = hash only, no files
+  void set_directory(const std::string& directory) { this->directory = directory; }
+
+  // Hash of the frame just drawn, 0 if it couldn't be read back
+  uint64_t capture(SDL_Renderer* renderer, uint32_t frame);
+
+  uint64_t get_run_hash() const { return run_hash; }
+  uint32_t get_num_of_frames() const { return num_of_frames; }
+
+private:
+  const static uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+  const static uint64_t FNV_PRIME = 1099511628211ull;
+
+  std::string directory;
+  // RGB24 rows, reused every frame
+  std::vector<uint8_t> pixels;
+  uint64_t run_hash;
+  uint32_t num_of_frames;
+
+  static uint64_t hash_bytes(const uint8_t* bytes, size_t size, uint64_t hash = FNV_OFFSET_BASIS);
+  bool write_ppm(const std::string& path, int width, int height) const;
+};
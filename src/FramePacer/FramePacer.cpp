@@ -0,0 +1,105 @@
+#include "./FramePacer.hpp"
+#include "../Logger/Logger.hpp"
+#include <SDL2/SDL_timer.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <chrono>
+#if defined(__unix__)
+#include <time.h>
+#endif
+
+FramePacer::FramePacer(uint16_t target_fps)
+  : counter_frequency{SDL_GetPerformanceFrequency()}, next_error_index{0} {
+  set_target_fps(target_fps);
+  reset();
+  Logger::Log("FramePacer Constructor called, performance counter at [" + std::to_string(counter_frequency) + "] Hz!");
+}
+
+void FramePacer::set_target_fps(uint16_t target_fps) {
+  this->target_fps = target_fps;
+  // Kept in counter ticks instead of ms, 1000 / 144 would truncate to 6ms
+  frame_period = (target_fps > 0) ? counter_frequency / target_fps : 0;
+}
+
+void FramePacer::reset() {
+  previous_frame = SDL_GetPerformanceCounter();
+  next_deadline = previous_frame + frame_period;
+  pacing_errors.clear();
+  next_error_index = 0;
+}
+
+int64_t FramePacer::counter_to_ns(int64_t counter) const {
+  return static_cast<int64_t>(static_cast<long double>(counter) * 1000000000.0L / counter_frequency);
+}
+
+void FramePacer::sleep_ns(int64_t ns) const {
+#if defined(__unix__)
+  timespec duration;
+  duration.tv_sec = ns / 1000000000;
+  duration.tv_nsec = ns % 1000000000;
+  // Restart if a signal wakes us, with whatever was left
+  while (clock_nanosleep(CLOCK_MONOTONIC, 0, &duration, &duration) != 0) {}
+#else
+  std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+#endif
+}
+
+double FramePacer::wait_for_next_frame() {
+  uint64_t now = SDL_GetPerformanceCounter();
+
+  if (frame_period > 0) {
+    // Sleep the bulk, then spin the last stretch for accuracy
+    int64_t remaining_ns = counter_to_ns(static_cast<int64_t>(next_deadline - now));
+    if (now < next_deadline && remaining_ns > SPIN_THRESHOLD_NS)
+      sleep_ns(remaining_ns - SPIN_THRESHOLD_NS);
+
+    now = SDL_GetPerformanceCounter();
+    while (now < next_deadline) {
+      std::this_thread::yield();
+      now = SDL_GetPerformanceCounter();
+    }
+
+    record_pacing_error(counter_to_ns(static_cast<int64_t>(now - next_deadline)));
+
+    // Fixed period keeps the average rate exact. If a frame ran over by
+    // more than a whole period, start fresh rather than rushing to catch up
+    next_deadline += frame_period;
+    if (now > next_deadline)
+      next_deadline = now + frame_period;
+  }
+
+  const double delta_time = static_cast<double>(now - previous_frame) / counter_frequency;
+  previous_frame = now;
+  return delta_time;
+}
+
+void FramePacer::record_pacing_error(int64_t error_ns) {
+  if (pacing_errors.size() < PACING_HISTORY_SIZE)
+    pacing_errors.push_back(error_ns);
+  else
+    pacing_errors[next_error_index] = error_ns;
+
+  next_error_index = (next_error_index + 1) % PACING_HISTORY_SIZE;
+}
+
+int64_t FramePacer::get_last_pacing_error_ns() const {
+  if (pacing_errors.empty()) return 0;
+  return pacing_errors[(next_error_index + PACING_HISTORY_SIZE - 1) % PACING_HISTORY_SIZE];
+}
+
+double FramePacer::get_mean_pacing_error_ns() const {
+  if (pacing_errors.empty()) return 0.0;
+
+  double total = 0.0;
+  for (auto error: pacing_errors)
+    total += std::abs(error);
+  return total / pacing_errors.size();
+}
+
+int64_t FramePacer::get_max_pacing_error_ns() const {
+  int64_t max_error = 0;
+  for (auto error: pacing_errors)
+    max_error = std::max<int64_t>(max_error, std::abs(error));
+  return max_error;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Paces the main loop to a target frame rate using the high
+// resolution performance counter.
+//
+// Sleeps with clock_nanosleep until close to the deadline,
+// then spins the rest of the way, since OS sleeps can wake a
+// millisecond or more late. Deadlines advance by a fixed
+// period so rounding never drifts the rate, and each frame's
+// lateness is recorded for checking how well it is holding up.
+///////////////////////////////////////////////////////////////
+class FramePacer {
+public:
+  FramePacer(uint16_t target_fps);
+  ~FramePacer() = default;
+
+  // 0 = uncapped, only measures
+  void set_target_fps(uint16_t target_fps);
+  uint16_t get_target_fps() const { return target_fps; }
+
+  // Start timing from now, so loading time isn't counted as a frame
+  void reset();
+
+  // Blocks until the next frame is due, returns the seconds since
+  // the previous frame started
+  double wait_for_next_frame();
+
+  // How late (+) or early (-) the most recent frame started
+  int64_t get_last_pacing_error_ns() const;
+  double get_mean_pacing_error_ns() const;
+  int64_t get_max_pacing_error_ns() const;
+
+private:
+  const static uint32_t PACING_HISTORY_SIZE = 256;
+  // Anything closer to the deadline than this is spun, not slept
+  const static int64_t SPIN_THRESHOLD_NS = 1500000;
+
+  uint16_t target_fps;
+  uint64_t counter_frequency;
+  uint64_t frame_period;
+  uint64_t previous_frame;
+  uint64_t next_deadline;
+
+  std::vector<int64_t> pacing_errors;
+  uint32_t next_error_index;
+
+  int64_t counter_to_ns(int64_t counter) const;
+  void sleep_ns(int64_t ns) const;
+  void record_pacing_error(int64_t error_ns);
+};
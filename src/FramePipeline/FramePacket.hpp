@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../AssetManager/AssetHandle.hpp"
+#include "../Components/StaticLayerComponent.hpp"
+#include "../DebugDraw/DebugDraw.hpp"
+#include "../RenderQueue/RenderQueue.hpp"
+
+// One sprite of a static layer, as RenderLayerSystem last saw it.
+// Layers are composited again whenever this changes
+struct StaticLayerMember {
+  uint32_t entity_id;
+  float x;
+  float y;
+  float width;
+  float height;
+  float rotation;
+  SDL_Rect src_rect;
+  uint16_t texture;
+  int8_t z_index;
+  SDL_RendererFlip flip;
+
+  bool operator==(const StaticLayerMember& other) const {
+    return entity_id == other.entity_id && x == other.x && y == other.y &&
+           width == other.width && height == other.height && rotation == other.rotation &&
+           src_rect.x == other.src_rect.x && src_rect.y == other.src_rect.y &&
+           src_rect.w == other.src_rect.w && src_rect.h == other.src_rect.h &&
+           texture == other.texture && z_index == other.z_index && flip == other.flip;
+  }
+  bool operator!=(const StaticLayerMember& other) const { return !(*this == other); }
+};
+
+// A string to draw, in screen space. The characters live in the
+// packet's text_bytes, so the command itself stays plain data
+struct TextCommand {
+  int x;
+  int y;
+  SDL_Color color;
+  FontHandle font;
+  // Drawn from the font's glyph atlas instead of the text cache
+  bool is_dynamic;
+  uint32_t text_offset;
+  uint32_t text_length;
+};
+
+///////////////////////////////////////////////////////////////
+// Everything a frame needs drawn, copied out of the registry at
+// the end of Game::Update. Rendering only ever reads a packet,
+// never a component, so it can run on another thread while the
+// next tick simulates (see FramePipeline).
+//
+// Only plain data and positions already interpolated and moved
+// into screen space (layers and the tilemap get the camera).
+// The vectors are cleared, not freed, between frames, after
+// the first few frames extraction doesn't allocate.
+///////////////////////////////////////////////////////////////
+struct FramePacket {
+  SDL_Rect camera;
+  uint16_t current_fps;
+  bool debug_enabled;
+
+  // In system order, RenderLayerSystem sorts them when it compares
+  std::vector<StaticLayerMember> layer_members[MAX_STATIC_LAYERS];
+  // Already sorted
+  RenderQueue sprites;
+  // Top left corner of each bullet on screen, all on bullet_texture_page
+  std::vector<SDL_FPoint> bullet_positions;
+  uint16_t bullet_texture_page;
+  // TextComponent text, then MovingTextComponent labels
+  std::vector<TextCommand> texts;
+  std::vector<TextCommand> labels;
+  std::vector<char> text_bytes;
+  // Health bars and collider boxes
+  DebugDraw overlays;
+
+  void clear() {
+    for (auto& members: layer_members)
+      members.clear();
+    sprites.clear();
+    bullet_positions.clear();
+    texts.clear();
+    labels.clear();
+    text_bytes.clear();
+    overlays.clear();
+  }
+
+  void push_text(std::vector<TextCommand>& commands, const std::string& text, int x, int y, SDL_Color color, FontHandle font, bool is_dynamic) {
+    commands.push_back({x, y, color, font, is_dynamic, static_cast<uint32_t>(text_bytes.size()), static_cast<uint32_t>(text.size())});
+    text_bytes.insert(text_bytes.end(), text.begin(), text.end());
+  }
+
+  // Copies a command's characters into out, which keeps its capacity
+  void get_text(const TextCommand& command, std::string& out) const {
+    out.assign(text_bytes.data() + command.text_offset, command.text_length);
+  }
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include "./FramePacket.hpp"
+
+// Packets in flight between simulation and rendering. With 2 the
+// simulation is at most one frame ahead of what's on screen
+const uint8_t FRAME_PIPELINE_DEPTH = 2;
+
+///////////////////////////////////////////////////////////////
+// Hands frame packets from the simulation to the renderer.
+//
+// The simulation fills a free packet while the renderer draws
+// the previous one, packets are drawn in the order they were
+// written. When every packet is taken the simulation waits for
+// the renderer instead of running ahead, so input to screen
+// latency stays bounded by the depth.
+//
+// Single threaded it still works: write a packet, then read it.
+///////////////////////////////////////////////////////////////
+class FramePipeline {
+public:
+  FramePipeline() {
+    for (auto& slot: slots)
+      slot.state = SLOT_FREE;
+  }
+
+  // Simulation side. Blocks until a packet is free, nullptr once stopped
+  FramePacket* begin_write() {
+    std::unique_lock<std::mutex> lock(mutex);
+    Slot* slot = nullptr;
+    slot_freed.wait(lock, [&] { return is_stopped || (slot = find_slot(SLOT_FREE)); });
+    if (is_stopped) return nullptr;
+
+    slot->state = SLOT_WRITING;
+    slot->packet.clear();
+    return &slot->packet;
+  }
+
+  // wait_until_drawn blocks until the renderer is done with the packet,
+  // for when rendering has to touch the registry (the debug GUI)
+  void end_write(FramePacket* packet, bool wait_until_drawn) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Slot& slot = get_slot(packet);
+    slot.state = SLOT_READY;
+    slot.sequence = next_sequence++;
+    slot_ready.notify_one();
+
+    if (wait_until_drawn)
+      slot_freed.wait(lock, [&] { return is_stopped || slot.state == SLOT_FREE; });
+  }
+
+  // Render side. The oldest packet written, nullptr if none turned up in time
+  FramePacket* begin_read(uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Slot* slot = nullptr;
+    slot_ready.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] { return is_stopped || (slot = find_oldest_ready()); });
+    if (!slot) return nullptr;
+
+    slot->state = SLOT_READING;
+    return &slot->packet;
+  }
+
+  void end_read(FramePacket* packet) {
+    std::lock_guard<std::mutex> lock(mutex);
+    get_slot(packet).state = SLOT_FREE;
+    slot_freed.notify_all();
+  }
+
+  // Wakes up and turns away both sides, for shutting down
+  void stop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    is_stopped = true;
+    slot_freed.notify_all();
+    slot_ready.notify_all();
+  }
+
+private:
+  enum SlotState : uint8_t { SLOT_FREE, SLOT_WRITING, SLOT_READY, SLOT_READING };
+
+  struct Slot {
+    FramePacket packet;
+    SlotState state;
+    uint64_t sequence = 0;
+  };
+
+  Slot slots[FRAME_PIPELINE_DEPTH];
+  uint64_t next_sequence = 0;
+  bool is_stopped = false;
+  std::mutex mutex;
+  std::condition_variable slot_freed;
+  std::condition_variable slot_ready;
+
+  Slot* find_slot(SlotState state) {
+    for (auto& slot: slots)
+      if (slot.state == state) return &slot;
+    return nullptr;
+  }
+
+  Slot* find_oldest_ready() {
+    Slot* oldest = nullptr;
+    for (auto& slot: slots)
+      if (slot.state == SLOT_READY && (!oldest || slot.sequence < oldest->sequence)) oldest = &slot;
+    return oldest;
+  }
+
+  Slot& get_slot(FramePacket* packet) {
+    for (auto& slot: slots)
+      if (&slot.packet == packet) return slot;
+    return slots[0];
+  }
+};
@@ -1,9 +1,12 @@
 #include <SDL2/SDL_mouse.h>
 #include <SDL2/SDL_ttf.h>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <random>
+#include <thread>
 #include "../ECS/ECS.hpp"
 #include "../../libs/glm/glm.hpp"
 #include "../Logger/Logger.hpp"
@@ -20,6 +23,8 @@
 #include "../Components/TextComponent.hpp"
 #include "../Components/MovingTextComponent.hpp"
 #include "../Components/GodModeComponent.hpp"
+#include "../Components/StaticLayerComponent.hpp"
+#include "../Components/BulletPatternComponent.hpp"
 #include "../Systems/MovementSystem.hpp"
 #include "../Systems/CameraMovementSystem.hpp"
 #include "../Systems/RenderSystem.hpp"
@@ -33,6 +38,11 @@
 #include "../Systems/MovingTextSystem.hpp"
 #include "../Systems/RenderHealthSystem.hpp"
 #include "../Systems/RenderGUISystem.hpp"
+#include "../Systems/BulletSystem.hpp"
+#include "../Systems/BulletPatternSystem.hpp"
+#include "../Systems/RenderBulletSystem.hpp"
+#include "../Systems/VisibilitySystem.hpp"
+#include "../Systems/RenderLayerSystem.hpp"
 #include "../../libs/imgui/imgui.h"
 #include "../../libs/imgui/backends/imgui_impl_sdl2.h"
 #include "../../libs/imgui/backends/imgui_impl_sdlrenderer2.h"
@@ -47,10 +57,31 @@ uint16_t Game::map_width;
 Game::Game() {
   is_running = false;
   debug_enabled = false;
+  fixed_timestep_enabled = true;
+  render_thread_enabled = true;
+  simulation_tick_rate = SIMULATION_TICK_RATE;
+  max_simulation_steps = MAX_SIMULATION_STEPS_PER_FRAME;
+  simulation_accumulator = 0.0;
+  interpolation_alpha = 1.0f;
+  starting_level = 1;
+  headless_enabled = false;
+  headless_width = DEFAULT_HEADLESS_WIDTH;
+  headless_height = DEFAULT_HEADLESS_HEIGHT;
+  max_frames = 0;
+  frame_hash_enabled = false;
+  frames_rendered = 0;
+  window = nullptr;
+  renderer = nullptr;
+  headless_surface = nullptr;
 
   registry = std::make_unique<Registry>();
   asset_manager = std::make_unique<AssetManager>();
   event_manager = std::make_unique<EventManager>();
+  thread_pool = std::make_unique<ThreadPool>();
+  frame_pacer = std::make_unique<FramePacer>(TARGET_FPS);
+  tilemap = std::make_unique<Tilemap>();
+  frame_pipeline = std::make_unique<FramePipeline>();
+  frame_capture = std::make_unique<FrameCapture>();
 
   Logger::Log("Game Constructor Called");
 }
@@ -73,6 +104,11 @@ void Game::LoadLevel(int level) {
   registry->add_system<MovingTextSystem>();
   registry->add_system<RenderHealthSystem>();
   registry->add_system<RenderGUISystem>();
+  registry->add_system<BulletSystem>();
+  registry->add_system<BulletPatternSystem>();
+  registry->add_system<RenderBulletSystem>();
+  registry->add_system<VisibilitySystem>();
+  registry->add_system<RenderLayerSystem>();
   // registry->add_system<AnimationSystem>();
 
   // The linker will find #includes properly, however, when using images etc you must do it from the
@@ -86,14 +122,24 @@ void Game::LoadLevel(int level) {
   asset_manager->add_texture(renderer, "asteroid-image", "./assets/images/space/background/Assets/layered/asteroid-1.png");
   asset_manager->add_texture(renderer, "planet-image", "./assets/images/space/background/Assets/layered/prop-planet-big.png");
   asset_manager->add_font("arial-font", "./assets/fonts/arial.ttf", 16);
+  if (level == 2)
+    asset_manager->add_texture(renderer, "jungle-tiles", "./assets/tilemaps/jungle.png");
+  // One page for all of the above so sprites batch across images
+  asset_manager->build_atlases(renderer);
 
   map_width = 2800; 
   map_height = 2240;
+
+  // The tilemap sets the size of the map, its chunks are baked as they come into view
+  if (level == 2 && tilemap->load("./assets/tilemaps/jungle.tilemap", "jungle-tiles", 32, 2)) {
+    map_width = tilemap->get_width();
+    map_height = tilemap->get_height();
+  }
   
-  const SDL_Color COLOR_RED = {255, 0, 0};
-  const SDL_Color COLOR_YELLOW = {255, 255, 0};
-  const SDL_Color COLOR_GREEN = {0, 255, 0};
-  const SDL_Color COLOR_WHITE = {255, 255, 255};
+  const SDL_Color COLOR_RED = {255, 0, 0, 255};
+  const SDL_Color COLOR_YELLOW = {255, 255, 0, 255};
+  const SDL_Color COLOR_GREEN = {0, 255, 0, 255};
+  const SDL_Color COLOR_WHITE = {255, 255, 255, 255};
 
   //////////////////////////////////////////////////////////////////////////////////////////////////// 
   // Playfield and HUD
@@ -101,16 +147,31 @@ void Game::LoadLevel(int level) {
   Entity playfield = registry->create_entity();
   playfield.tag("playfield");
   playfield.add_component<TransformComponent>(glm::vec2(0), glm::vec2(1), 0.0);
-  playfield.add_component<SpriteComponent>("background", map_width, map_height, 0, 0, -1);
+  if (!tilemap->is_loaded()) {
+    playfield.add_component<SpriteComponent>("background", map_width, map_height, 0, 0, -1);
+    playfield.add_component<StaticLayerComponent>(STATIC_LAYER_BACKGROUND);
+  }
+  // The background scrolls at half speed, behind everything else
+  registry->get_system<RenderLayerSystem>().set_parallax(STATIC_LAYER_BACKGROUND, 0.5f);
+  registry->get_system<RenderLayerSystem>().set_parallax(STATIC_LAYER_DECORATION, 1.0f);
+
+  // Stands in for every solid tile, hits on it are handled like any other object
+  if (tilemap->is_loaded()) {
+    Entity tilemap_entity = registry->create_entity();
+    tilemap_entity.tag("tilemap");
+    tilemap_entity.group("object");
+    tilemap_entity.add_component<CollisionComponent>();
+    registry->get_system<CollisionSystem>().set_tilemap(tilemap.get(), tilemap_entity);
+  }
 
   Entity display_fps = registry->create_entity();
   display_fps.tag("fps");
-  display_fps.add_component<TextComponent>(true, glm::vec2(0, 500), "", "arial-font", COLOR_WHITE);
+  display_fps.add_component<TextComponent>(true, glm::vec2(0, 500), "", "arial-font", COLOR_WHITE, true);
 
   // TODO: Score functionality
   Entity display_score = registry->create_entity();
   display_score.tag("score");
-  display_score.add_component<TextComponent>(true, glm::vec2(0, 520), "Score: ", "arial-font", COLOR_WHITE);
+  display_score.add_component<TextComponent>(true, glm::vec2(0, 520), "Score: ", "arial-font", COLOR_WHITE, true);
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /// Entities
@@ -169,64 +230,216 @@ void Game::LoadLevel(int level) {
   planet.add_component<TransformComponent>(glm::vec2(25, 200), glm::vec2(4.0, 4.0), 0.0);
   planet.add_component<RigidBodyComponent>(glm::vec2(0.0, 0.0));
   planet.add_component<SpriteComponent>("planet-image", 126, 126, 0, 0, 1, false);
+  planet.add_component<StaticLayerComponent>(STATIC_LAYER_DECORATION);
 }
 
 void Game::Setup() {
-  LoadLevel(1);
+  LoadLevel(scenario ? scenario->level : starting_level);
+  if (scenario) SpawnScenario(*scenario);
+}
+
+// Fills the map with the scenario's ships and emitters, placed from its seed
+// so every run of it starts the same
+void Game::SpawnScenario(const Scenario& scenario) {
+  map_width = scenario.map_width;
+  map_height = scenario.map_height;
+
+  // The space background stretches over the whole map
+  Entity playfield = registry->get_entity_by_tag("playfield");
+  if (playfield.has_component<SpriteComponent>()) {
+    auto& sprite = playfield.get_component<SpriteComponent>();
+    sprite.width = map_width;
+    sprite.height = map_height;
+  }
+
+  // Ships bounce off the map edges instead of being removed, and neither
+  // they nor the player can die, so the entity count holds for the whole run
+  registry->get_system<MovementSystem>().set_bounce_at_edges(true);
+  Entity player = registry->get_entity_by_tag("player");
+  if (player.has_component<GodModeComponent>())
+    player.get_component<GodModeComponent>().god_mode_enabled = true;
+
+  std::mt19937 rng(scenario.seed);
+  std::uniform_real_distribution<float> position_x(0.0f, map_width - 96.0f);
+  std::uniform_real_distribution<float> position_y(0.0f, map_height - 96.0f);
+  std::uniform_real_distribution<float> velocity(-120.0f, 120.0f);
+  std::uniform_real_distribution<float> rotation(0.0f, 360.0f);
+  const SDL_Color COLOR_RED = {255, 0, 0, 255};
+
+  for (uint32_t i = 0; i < scenario.ships; i++) {
+    Entity ship = registry->create_entity();
+    ship.group("enemy");
+    ship.add_component<TransformComponent>(glm::vec2(position_x(rng), position_y(rng)), glm::vec2(2.0, 2.0), rotation(rng));
+    ship.add_component<RigidBodyComponent>(glm::vec2(velocity(rng), velocity(rng)));
+    ship.add_component<SpriteComponent>("player-hurt-image", 48, 48, 0, 0, 3);
+    ship.add_component<BoxColliderComponent>(34, 33, glm::vec2(14, 15));
+    ship.add_component<CollisionComponent>();
+    ship.add_component<HealthComponent>(100);
+    ship.add_component<GodModeComponent>(true);
+    ship.add_component<MovingTextComponent>(7, -15, "Enemy spaceship", "arial-font", COLOR_RED);
+
+    if (i < scenario.emitters)
+      ship.add_component<ProjectileEmitterComponent>(glm::vec2(velocity(rng) * 2.0f, velocity(rng) * 2.0f), 1000, 3000, 10, false);
+  }
+
+  for (uint32_t i = 0; i < scenario.bullet_patterns; i++) {
+    Entity turret = registry->create_entity();
+    turret.group("enemy");
+    turret.add_component<TransformComponent>(glm::vec2(position_x(rng), position_y(rng)), glm::vec2(2.0, 2.0), 0.0);
+    turret.add_component<SpriteComponent>("player-dying-image", 48, 48, 0, 0, 4);
+    turret.add_component<BulletPatternComponent>(scenario.pattern_bullets, 200, scenario.pattern_repeat_ms, 5000, 1, false, 7.5f, registry->get_clock().get_ticks());
+  }
+
+  Logger::Log("Scenario [" + scenario.name + "] spawned " + std::to_string(scenario.ships) + " ships, " +
+              std::to_string(scenario.emitters) + " emitters, " + std::to_string(scenario.bullet_patterns) + " bullet patterns");
 }
 
 void Game::Update() {
-  // Yield resources to OS
-  uint32_t time_to_wait = MS_PER_FRAME - (SDL_GetTicks() - ms_previous_frame);
-  if (time_to_wait > 0 && time_to_wait <= MS_PER_FRAME)
-    SDL_Delay(time_to_wait);
- 
-  // DT is diff in ticks since last frame, converted to seconds
-  double delta_time = (SDL_GetTicks() - ms_previous_frame) / 1000.0;
+  // Yield resources to OS until the next frame is due,
+  // DT is the real time since last frame in seconds. Headless
+  // runs don't wait, every frame is exactly one tick so two runs
+  // of the same scene draw the same frames
+  double delta_time = headless_enabled ? 1.0 / simulation_tick_rate : frame_pacer->wait_for_next_frame();
+
+  current_fps = (delta_time > 0.0) ? static_cast<uint16_t>(1 / delta_time) : 0;
+
+  if (fixed_timestep_enabled) {
+    // Run whole ticks for the time that has built up, the leftover
+    // carries over and says how far to interpolate when rendering
+    const double step = 1.0 / simulation_tick_rate;
+    uint8_t steps = 0;
+
+    simulation_accumulator += delta_time;
+    while (simulation_accumulator >= step && steps < max_simulation_steps) {
+      Simulate(step);
+      simulation_accumulator -= step;
+      steps++;
+    }
+
+    // Too far behind (breakpoint, window drag...), drop the backlog
+    // instead of spiralling
+    if (simulation_accumulator >= step)
+      simulation_accumulator = 0.0;
+
+    interpolation_alpha = static_cast<float>(simulation_accumulator / step);
+  }
+  else {
+    Simulate(delta_time);
+    interpolation_alpha = 1.0f;
+  }
+
+  registry->get_system<CameraMovementSystem>().Update(camera, interpolation_alpha);
+
+  // Hand the frame over to rendering. With the debug GUI up the render
+  // thread touches the registry, so wait for it to finish before ticking again
+  FramePacket* packet = frame_pipeline->begin_write();
+  if (!packet) return;
+  Extract(*packet);
+  frame_pipeline->end_write(packet, render_thread_enabled && !profiler && packet->debug_enabled);
+}
 
-  current_fps = static_cast<int>(1 / delta_time);
+void Game::Simulate(double delta_time) {
+  ProfileScope simulate_scope(profiler.get(), "Simulate");
 
-  // Store current frame time
-  ms_previous_frame = SDL_GetTicks();
+  // Sample game time once for the whole tick, paused or slowed down
+  // time shrinks the step every system sees
+  delta_time = registry->get_clock().tick(delta_time);
 
-  // Reset event handlers for current frame
+  // Reset event handlers for current tick
   event_manager->reset();
 
-  // Only valid for this current frame
+  // Only valid for this current tick
   registry->get_system<MovementSystem>().ListenForEvents(event_manager);
   registry->get_system<DamageSystem>().ListenForEvents(event_manager);
   registry->get_system<KeyboardMovementSystem>().ListenForEvents(event_manager);
   registry->get_system<ProjectileEmitterSystem>().ListenForEvents(event_manager);
-  registry->get_system<MovementSystem>().Update(delta_time);
-  registry->get_system<CollisionSystem>().Update(event_manager);
-  registry->get_system<CameraMovementSystem>().Update(camera);
-  registry->get_system<ProjectileEmitterSystem>().Update(registry);
-  registry->get_system<ProjectileDurationSystem>().Update();
-  // registry->get_system<AnimationSystem>().Update();
+  // Each timed when a profiler is attached, nothing otherwise
+  SystemProfiler* system_profiler = profiler.get();
+  { ProfileScope scope(system_profiler, "MovementSystem"); registry->get_system<MovementSystem>().Update(delta_time); }
+  { ProfileScope scope(system_profiler, "CollisionSystem"); registry->get_system<CollisionSystem>().Update(event_manager, thread_pool, delta_time); }
+  { ProfileScope scope(system_profiler, "BulletSystem"); registry->get_system<BulletSystem>().Update(event_manager, delta_time); }
+  { ProfileScope scope(system_profiler, "ProjectileEmitterSystem"); registry->get_system<ProjectileEmitterSystem>().Update(registry); }
+  { ProfileScope scope(system_profiler, "BulletPatternSystem"); registry->get_system<BulletPatternSystem>().Update(registry); }
+  { ProfileScope scope(system_profiler, "ProjectileDurationSystem"); registry->get_system<ProjectileDurationSystem>().Update(registry); }
+  // registry->get_system<AnimationSystem>().Update(registry);
 
   // Process entities that are waiting to be created/destroyed
+  ProfileScope scope(system_profiler, "Registry::update");
   registry->update();
 }
 
-void Game::Render() {
+// Copies out everything the renderer needs, runs on the simulation side
+void Game::Extract(FramePacket& packet) {
+  packet.camera = camera;
+  packet.current_fps = current_fps;
+  packet.debug_enabled = debug_enabled;
+
+  // Every extraction below only walks what this finds on screen
+  {
+    ProfileScope scope(profiler.get(), "VisibilitySystem");
+    registry->get_system<VisibilitySystem>().Update(camera, interpolation_alpha);
+  }
+  const auto& visibility = registry->get_system<VisibilitySystem>();
+  ProfileScope scope(profiler.get(), "Extract");
+
+  registry->get_system<RenderLayerSystem>().Extract(packet);
+  registry->get_system<RenderSystem>().Extract(asset_manager, visibility, camera, interpolation_alpha, packet);
+  registry->get_system<RenderBulletSystem>().Extract(asset_manager, camera, registry->get_system<BulletSystem>().get_bullets(), interpolation_alpha, packet);
+  registry->get_system<RenderTextSystem>().Extract(camera, current_fps, packet);
+  registry->get_system<MovingTextSystem>().Extract(visibility, camera, interpolation_alpha, packet);
+  registry->get_system<RenderHealthSystem>().Extract(packet.overlays, visibility, camera, interpolation_alpha);
+  if (debug_enabled)
+    registry->get_system<RenderCollisionSystem>().Extract(packet.overlays, visibility, camera);
+}
+
+// Draws a packet, runs on the thread that owns the renderer
+void Game::Render(FramePacket& packet) {
+  ProfileScope scope(profiler.get(), "Render");
   SDL_SetRenderDrawColor(renderer, 21, 21, 21, 255);
   SDL_RenderClear(renderer);
 
-  registry->get_system<RenderSystem>().Update(renderer, asset_manager, camera);
-  registry->get_system<RenderTextSystem>().Update(asset_manager, renderer, camera, current_fps);
-  registry->get_system<MovingTextSystem>().Update(asset_manager, renderer, camera);
-  registry->get_system<RenderHealthSystem>().Update(renderer, camera);
-
-  if (debug_enabled) {
-    registry->get_system<RenderCollisionSystem>().Update(renderer, camera);
+  // Cached static layers, one copy each: the background, the tilemap's
+  // chunks in view, then the decoration over the map
+  registry->get_system<RenderLayerSystem>().Render(renderer, asset_manager, packet, false);
+  tilemap->render(renderer, asset_manager, packet.camera);
+  registry->get_system<RenderLayerSystem>().Render(renderer, asset_manager, packet, true);
+
+  registry->get_system<RenderSystem>().Render(renderer, asset_manager, packet);
+  registry->get_system<RenderBulletSystem>().Render(renderer, asset_manager, packet);
+  registry->get_system<RenderTextSystem>().Render(renderer, asset_manager, packet);
+  registry->get_system<MovingTextSystem>().Render(renderer, asset_manager, packet);
+  // Health bars and collider boxes, grouped by colour
+  packet.overlays.flush(renderer);
+
+  // The simulation is parked until this packet is done (see Update)
+  if (packet.debug_enabled && !headless_enabled)
     registry->get_system<RenderGUISystem>().Update(renderer, registry);
+
+  frames_rendered++;
+
+  if (headless_enabled) {
+    // Nothing to present, the frame is read straight off the surface
+    if (frame_hash_enabled || !capture_directory.empty()) {
+      const uint64_t frame_hash = frame_capture->capture(renderer, frames_rendered);
+      if (frame_hash_enabled)
+        std::printf("frame %u %016llx\n", frames_rendered, static_cast<unsigned long long>(frame_hash));
+    }
+  }
+  else {
+    // Double buffer
+    SDL_RenderPresent(renderer);
   }
 
-  // Double buffer
-  SDL_RenderPresent(renderer);
+  if (max_frames != 0 && frames_rendered >= max_frames)
+    is_running = false;
 };
 
 void Game::Initialize() {
+  if (headless_enabled) {
+    InitializeHeadless();
+    return;
+  }
+
   if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
     Logger::Err("SDL failed to Initialize!");
     return;
@@ -332,20 +545,107 @@ void Game::Initialize() {
   is_running = true;
 };
 
+// For machines without a display or GPU (CI): the offscreen or dummy video
+// driver, and a software renderer drawing into a surface instead of a window
+void Game::InitializeHeadless() {
+  // Whatever the environment asks for wins, then offscreen, then dummy
+  const bool driver_forced = SDL_getenv("SDL_VIDEODRIVER") != nullptr;
+  if (!driver_forced) SDL_setenv("SDL_VIDEODRIVER", "offscreen", 1);
+
+  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0) {
+    if (driver_forced) {
+      Logger::Err(std::string("SDL failed to Initialize headless: ") + SDL_GetError());
+      return;
+    }
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0) {
+      Logger::Err(std::string("SDL failed to Initialize headless: ") + SDL_GetError());
+      return;
+    }
+  }
+
+  if (TTF_Init() != 0) {
+    Logger::Err("TTF failed to initialize!");
+    return;
+  }
+
+  WINDOW_WIDTH = headless_width;
+  WINDOW_HEIGHT = headless_height;
+
+  headless_surface = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+  renderer = headless_surface ? SDL_CreateSoftwareRenderer(headless_surface) : nullptr;
+  if (!renderer) {
+    Logger::Err(std::string("Failed to create headless renderer: ") + SDL_GetError());
+    return;
+  }
+
+  frame_capture->set_directory(capture_directory);
+  const char* video_driver = SDL_GetCurrentVideoDriver();
+  Logger::Log("Headless at " + std::to_string(WINDOW_WIDTH) + "x" + std::to_string(WINDOW_HEIGHT) + " on the " + (video_driver ? video_driver : "no") + " video driver");
+
+  camera.x = 0;
+  camera.y = 0;
+  camera.w = WINDOW_WIDTH;
+  camera.h = WINDOW_HEIGHT;
+  is_running = true;
+}
+
 void Game::Run() {
   Setup();
+  frame_pacer->reset();
+
+  // The profiler isn't thread safe, and overlapping frames wouldn't time apart
+  if (!render_thread_enabled || profiler) {
+    while (is_running) {
+      if (profiler) profiler->begin_frame();
+      ProcessInput();
+      DispatchInput();
+      Update();
+
+      FramePacket* packet = frame_pipeline->begin_read(0);
+      if (!packet) continue;
+      Render(*packet);
+      frame_pipeline->end_read(packet);
+
+      if (profiler) {
+        const uint32_t num_of_entities = registry->get_system<VisibilitySystem>().get_num_of_entities() +
+                                         registry->get_system<BulletSystem>().get_num_of_bullets();
+        profiler->end_frame(num_of_entities);
+      }
+    }
+    return;
+  }
+
+  // SDL wants events and the renderer on the thread that made the window,
+  // so that one renders and the simulation moves to a worker
+  std::thread simulation_thread([this]() {
+    while (is_running) {
+      DispatchInput();
+      Update();
+    }
+    frame_pipeline->stop();
+  });
+
   while (is_running) {
     ProcessInput();
-    Update();
-    Render();
+
+    FramePacket* packet = frame_pipeline->begin_read(FRAME_WAIT_TIMEOUT_MS);
+    if (!packet) continue;
+    Render(*packet);
+    frame_pipeline->end_read(packet);
   }
+
+  // Wakes the simulation if it's waiting on a free packet
+  frame_pipeline->stop();
+  simulation_thread.join();
 };
 
 void Game::ProcessInput() {
   SDL_Event sdl_event;
 
   while (SDL_PollEvent(&sdl_event)) {
-    ImGui_ImplSDL2_ProcessEvent(&sdl_event);
+    if (!headless_enabled)
+      ImGui_ImplSDL2_ProcessEvent(&sdl_event);
 
     switch (sdl_event.type) {
       case SDL_QUIT:
@@ -353,27 +653,60 @@ void Game::ProcessInput() {
         break;
 
       case SDL_KEYDOWN:
-        event_manager->emit_event<KeyPressedEvent>(sdl_event);
-
         if (sdl_event.key.keysym.sym == SDLK_ESCAPE) {
           is_running = false;
           break;
         }
 
-        if (sdl_event.key.keysym.sym == SDLK_F1) {
-          (!debug_enabled) ? debug_enabled = true : debug_enabled = false;
-          break;
+        // Everything else is for the simulation, picked up on its next tick
+        {
+          std::lock_guard<std::mutex> lock(input_mutex);
+          if (queued_input.size() < MAX_QUEUED_INPUT_EVENTS)
+            queued_input.push_back(sdl_event);
         }
+        break;
+
+      // The driver dropped every render target, chunks and layers included
+      case SDL_RENDER_TARGETS_RESET:
+        tilemap->invalidate();
+        registry->get_system<RenderLayerSystem>().invalidate();
+        break;
     }
   }
 };
 
+// Simulation side, emits the key presses ProcessInput queued up
+void Game::DispatchInput() {
+  {
+    std::lock_guard<std::mutex> lock(input_mutex);
+    dispatched_input.swap(queued_input);
+  }
+
+  for (auto& sdl_event: dispatched_input) {
+    event_manager->emit_event<KeyPressedEvent>(sdl_event);
+
+    if (sdl_event.key.keysym.sym == SDLK_F1)
+      (!debug_enabled) ? debug_enabled = true : debug_enabled = false;
+  }
+  dispatched_input.clear();
+}
+
 void Game::Destroy() {
-  ImGui_ImplSDLRenderer2_Shutdown();
-  ImGui_ImplSDL2_Shutdown();
-  ImGui::DestroyContext();
+  if (!headless_enabled) {
+    ImGui_ImplSDLRenderer2_Shutdown();
+    ImGui_ImplSDL2_Shutdown();
+    ImGui::DestroyContext();
+  }
+  else if (frame_capture->get_num_of_frames() > 0) {
+    // One line to compare between runs
+    std::printf("frames %u hash %016llx\n", frame_capture->get_num_of_frames(), static_cast<unsigned long long>(frame_capture->get_run_hash()));
+  }
 
-  SDL_DestroyWindow(window);
+  // Chunk and layer textures belong to the renderer
+  tilemap->clear();
+  registry->get_system<RenderLayerSystem>().invalidate();
   SDL_DestroyRenderer(renderer);
+  if (window) SDL_DestroyWindow(window);
+  if (headless_surface) SDL_FreeSurface(headless_surface);
   SDL_Quit();
 };
@@ -1,17 +1,40 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SDL2/SDL_events.h>
 #include <SDL2/SDL_render.h>
 #include <SDL2/SDL_video.h>
 #include <SDL2/SDL_image.h>
 #include "../ECS/ECS.hpp"
 #include "../AssetManager/AssetManager.hpp"
 #include "../EventManager/EventManager.hpp"
+#include "../ThreadPool/ThreadPool.hpp"
+#include "../FramePacer/FramePacer.hpp"
+#include "../Tilemap/Tilemap.hpp"
+#include "../FramePipeline/FramePipeline.hpp"
+#include "../FrameCapture/FrameCapture.hpp"
+#include "../Profiler/SystemProfiler.hpp"
+#include "../Scenario/Scenario.hpp"
 
+// Default frame cap, FramePacer can be retargeted at runtime (0 = uncapped)
 const uint16_t TARGET_FPS = 144;
-// 1000ms -> 1 second. Each frame should take 16.6 repeating ms
-const uint16_t MS_PER_FRAME = 1000 / TARGET_FPS;
+// Simulation ticks per second when running with a fixed timestep,
+// and how many ticks a slow frame may run to catch up before the
+// remaining time is dropped
+const uint16_t SIMULATION_TICK_RATE = 120;
+const uint8_t MAX_SIMULATION_STEPS_PER_FRAME = 5;
+// How long the render thread waits for a frame before pumping events again
+const uint32_t FRAME_WAIT_TIMEOUT_MS = 50;
+// Key presses the simulation hasn't picked up yet, past this they're dropped
+const uint16_t MAX_QUEUED_INPUT_EVENTS = 256;
 const int8_t DEFAULT_MONITOR_NUMBER = -1;
+// Headless frame size when none is given
+const uint16_t DEFAULT_HEADLESS_WIDTH = 1280;
+const uint16_t DEFAULT_HEADLESS_HEIGHT = 720;
 const uint32_t timer = 0;
 const uint32_t score = 0;
 
@@ -20,28 +43,71 @@ public:
   Game();
   ~Game();
   void Initialize();
+  void InitializeHeadless();
   void Run();
   void Setup();
   void LoadLevel(int level);
+  void SpawnScenario(const Scenario& scenario);
   void ProcessInput();
+  void DispatchInput();
   void Update();
-  void Render();
+  void Simulate(double delta_time);
+  void Extract(FramePacket& packet);
+  void Render(FramePacket& packet);
   void Destroy();
 
   static uint16_t WINDOW_WIDTH;
   static uint16_t WINDOW_HEIGHT;
   static uint16_t map_width;
   static uint16_t map_height;
-  bool is_running;
+  // Cleared by the main thread, read by the simulation thread
+  std::atomic<bool> is_running;
   bool debug_enabled;
+  bool fixed_timestep_enabled;
+  // Simulate on a worker thread while the main thread renders the
+  // previous frame. Off = both back to back on the main thread
+  bool render_thread_enabled;
+  uint16_t simulation_tick_rate;
+  uint8_t max_simulation_steps;
+  // Level Setup() loads, 1 = space, 2 = jungle tilemap
+  int starting_level;
+  // No window, GPU or ImGui: a software renderer draws into a surface
+  // that's never presented, one fixed simulation tick per frame
+  bool headless_enabled;
+  uint16_t headless_width;
+  uint16_t headless_height;
+  // Stop after this many frames, 0 = run until quit
+  uint32_t max_frames;
+  // Headless only, log a hash of every frame / write them out as PPMs
+  bool frame_hash_enabled;
+  std::string capture_directory;
+  // Spawned on top of its level by Setup(), none = just starting_level
+  std::unique_ptr<Scenario> scenario;
+  // Per system timings when set, forces the single threaded loop
+  std::unique_ptr<SystemProfiler> profiler;
 
 private:
   SDL_Window* window;
   SDL_Renderer* renderer;
+  // What the headless renderer draws into
+  SDL_Surface* headless_surface;
   SDL_Rect camera;
-  uint32_t ms_previous_frame = 0;
   std::unique_ptr<Registry> registry;
   std::unique_ptr<AssetManager> asset_manager;
   std::unique_ptr<EventManager> event_manager;
+  std::unique_ptr<ThreadPool> thread_pool;
+  std::unique_ptr<FramePacer> frame_pacer;
+  std::unique_ptr<Tilemap> tilemap;
+  std::unique_ptr<FramePipeline> frame_pipeline;
+  std::unique_ptr<FrameCapture> frame_capture;
+  uint32_t frames_rendered;
+  // Key presses from the main thread waiting for the next tick
+  std::mutex input_mutex;
+  std::vector<SDL_Event> queued_input;
+  std::vector<SDL_Event> dispatched_input;
   uint16_t current_fps;
+  double simulation_accumulator;
+  // How far between the previous and current simulation tick
+  // the frame being rendered is (0 = previous, 1 = current)
+  float interpolation_alpha;
 };
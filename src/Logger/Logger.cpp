@@ -2,14 +2,40 @@
 #include <chrono>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
+#include <atomic>
+#include <ctime>
 #include "./Logger.hpp"
 
 std::vector<LogEntry> Logger::all_messages;
 
+// The simulation and render threads both log, one message at a time
+static std::mutex log_mutex;
+static std::atomic<int> log_level {LOG_INFO};
+static std::atomic<bool> log_enabled {true};
+
+static bool should_log(LogType type) {
+  return log_enabled.load(std::memory_order_relaxed) && type >= log_level.load(std::memory_order_relaxed);
+}
+
+void Logger::set_level(LogType level) {
+  log_level = level;
+}
+
+void Logger::set_enabled(bool enabled) {
+  log_enabled = enabled;
+}
+
 std::string get_formatted_time() {
   const auto now = std::chrono::system_clock::now();
   const auto current_time = std::chrono::system_clock::to_time_t(now);
-  std::tm time = *std::localtime(&current_time);
+  // std::localtime shares one buffer between threads
+  std::tm time;
+#if defined(_WIN32)
+  localtime_s(&time, &current_time);
+#else
+  localtime_r(&current_time, &time);
+#endif
 
   std::ostringstream oss;
   oss << std::put_time(&time, "%r");
@@ -18,27 +44,39 @@ std::string get_formatted_time() {
 }
 
 void Logger::Log(const std::string& message) {
+  if (!should_log(LOG_INFO)) return;
+
   LogEntry log_entry;
   log_entry.type = LOG_INFO;
   log_entry.message = "LOG: [" + get_formatted_time() + "] " + message;
+
+  std::lock_guard<std::mutex> lock(log_mutex);
   all_messages.push_back(log_entry);
 
   std::cout << CONSOLE_COLOR_GREEN << log_entry.message << CONSOLE_RESET_COLOR << std::endl;
 }
 
 void Logger::Err(const std::string& message) {
+  if (!should_log(LOG_ERROR)) return;
+
   LogEntry log_entry;
   log_entry.type = LOG_ERROR;
   log_entry.message = "ERROR: [" + get_formatted_time() + "] " + message;
+
+  std::lock_guard<std::mutex> lock(log_mutex);
   all_messages.push_back(log_entry);
 
   std::cerr << CONSOLE_COLOR_RED << log_entry.message << CONSOLE_RESET_COLOR << std::endl; 
 }
 
 void Logger::Warn(const std::string& message) {
+  if (!should_log(LOG_WARNING)) return;
+
   LogEntry log_entry;
   log_entry.type = LOG_WARNING;
   log_entry.message = "WARNING: [" + get_formatted_time() + "] " + message;
+
+  std::lock_guard<std::mutex> lock(log_mutex);
   all_messages.push_back(log_entry);
 
   std::cout << CONSOLE_COLOR_YELLOW << log_entry.message << CONSOLE_RESET_COLOR << std::endl; 
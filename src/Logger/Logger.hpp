@@ -24,4 +24,9 @@ class Logger {
     static void Log(const std::string& message);
     static void Err(const std::string& message);
     static void Warn(const std::string& message);
+
+    // Messages below the level, or all of them while disabled, are dropped
+    // before being formatted, printed or kept in all_messages
+    static void set_level(LogType level);
+    static void set_enabled(bool enabled);
 };
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Per frame timings of named sections (systems, extraction,
+// rendering...) for benchmarking.
+//
+// A section can run more than once a frame (a catch-up frame
+// runs several ticks), its time is summed and recorded once in
+// end_frame(), so every section has one sample per frame and
+// the percentiles are per frame. Section names are expected to
+// be string literals, they're compared by pointer first.
+//
+// Not thread safe: profile single threaded runs.
+///////////////////////////////////////////////////////////////
+class SystemProfiler {
+public:
+  struct Section {
+    const char* name;
+    // Nanoseconds this frame, so far
+    uint64_t frame_ns;
+    bool ran_this_frame;
+    // Nanoseconds per frame the section ran in
+    std::vector<uint64_t> samples;
+  };
+
+  struct Stats {
+    double mean_us;
+    double p50_us;
+    double p99_us;
+    double max_us;
+  };
+
+  void begin_frame() {
+    frame_start = std::chrono::steady_clock::now();
+  }
+
+  // num_of_entities = how many were simulated this frame, for the throughput
+  void end_frame(uint32_t num_of_entities) {
+    const auto frame_end = std::chrono::steady_clock::now();
+    frame_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(frame_end - frame_start).count());
+    entity_frames += num_of_entities;
+    min_entities = frame_samples.size() == 1 ? num_of_entities : std::min(min_entities, num_of_entities);
+    max_entities = std::max(max_entities, num_of_entities);
+
+    for (auto& section: sections) {
+      if (!section.ran_this_frame) continue;
+      section.samples.push_back(section.frame_ns);
+      section.frame_ns = 0;
+      section.ran_this_frame = false;
+    }
+  }
+
+  void add_sample(const char* name, uint64_t ns) {
+    Section& section = get_section(name);
+    section.frame_ns += ns;
+    section.ran_this_frame = true;
+  }
+
+  const std::vector<Section>& get_sections() const { return sections; }
+  const std::vector<uint64_t>& get_frame_samples() const { return frame_samples; }
+  uint32_t get_num_of_frames() const { return static_cast<uint32_t>(frame_samples.size()); }
+  uint64_t get_entity_frames() const { return entity_frames; }
+  // Fewest and most entities simulated in one frame
+  uint32_t get_min_entities() const { return min_entities; }
+  uint32_t get_max_entities() const { return max_entities; }
+
+  double get_total_seconds() const {
+    uint64_t total_ns = 0;
+    for (auto sample: frame_samples) total_ns += sample;
+    return total_ns * 1e-9;
+  }
+
+  // Nearest rank percentiles
+  static Stats get_stats(std::vector<uint64_t> samples) {
+    Stats stats = {0.0, 0.0, 0.0, 0.0};
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+    uint64_t total_ns = 0;
+    for (auto sample: samples) total_ns += sample;
+
+    auto percentile = [&](double p) {
+      const size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+      return samples[std::max<size_t>(rank, 1) - 1] * 1e-3;
+    };
+
+    stats.mean_us = static_cast<double>(total_ns) / samples.size() * 1e-3;
+    stats.p50_us = percentile(0.50);
+    stats.p99_us = percentile(0.99);
+    stats.max_us = samples.back() * 1e-3;
+    return stats;
+  }
+
+private:
+  std::vector<Section> sections;
+  std::vector<uint64_t> frame_samples;
+  uint64_t entity_frames = 0;
+  uint32_t min_entities = 0;
+  uint32_t max_entities = 0;
+  std::chrono::steady_clock::time_point frame_start;
+
+  Section& get_section(const char* name) {
+    for (auto& section: sections)
+      if (section.name == name || std::strcmp(section.name, name) == 0) return section;
+
+    sections.push_back({name, 0, false, {}});
+    return sections.back();
+  }
+};
+
+///////////////////////////////////////////////////////////////
+// Times its own lifetime into a profiler section, a null
+// profiler makes it free (one branch), so calls can stay in
+// place when nothing is being measured.
+///////////////////////////////////////////////////////////////
+class ProfileScope {
+public:
+  ProfileScope(SystemProfiler* profiler, const char* name) : profiler{profiler}, name{name} {
+    if (profiler) start = std::chrono::steady_clock::now();
+  }
+
+  ~ProfileScope() {
+    if (!profiler) return;
+    const auto end = std::chrono::steady_clock::now();
+    profiler->add_sample(name, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  SystemProfiler* profiler;
+  const char* name;
+  std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <SDL2/SDL.h>
+
+///////////////////////////////////////////////////////////////
+// One sprite draw, culled and resolved ahead of time so the
+// draw loop never touches a component. Plain data only, the
+// queue moves these around freely.
+///////////////////////////////////////////////////////////////
+struct RenderCommand {
+  SDL_Rect src_rect;
+  SDL_Rect dst_rect;
+  float rotation;
+  SDL_RendererFlip flip;
+  // AssetManager page the src rect is on, sprites sharing a page
+  // (e.g. an atlas) can be drawn together
+  uint16_t texture_page;
+};
+
+enum RenderLayer : uint8_t {
+  RENDER_LAYER_WORLD = 0,
+  // Screen space sprites (is_fixed), drawn over the world
+  RENDER_LAYER_FIXED = 1
+};
+
+///////////////////////////////////////////////////////////////
+// Draw commands for a frame, ordered by a packed 64-bit key:
+//
+//   63      56 55      48 47             32 31              0
+//  [  layer  ][ z_index ][  texture page  ][    sequence     ]
+//
+// z_index is biased to unsigned so -1 sorts before 0. The
+// sequence is the command's index in the queue, which makes
+// every key unique (the order never depends on the sort) and
+// means only the keys need sorting, the low 32 bits say where
+// the command is.
+//
+// Sorting is an LSD radix sort, 8 passes of 8 bits, linear in
+// the number of commands. A pass is skipped when every key has
+// the same byte there, so a frame with one layer and a handful
+// of z levels only pays for the bytes that actually differ.
+// Sprites on the same page and z end up next to each other.
+///////////////////////////////////////////////////////////////
+class RenderQueue {
+public:
+  void clear() {
+    commands.clear();
+    keys.clear();
+  }
+
+  void reserve(uint32_t capacity) {
+    commands.reserve(capacity);
+    keys.reserve(capacity);
+  }
+
+  void push(RenderLayer layer, int8_t z_index, const RenderCommand& command) {
+    const uint64_t sequence = commands.size();
+    const uint64_t biased_z = static_cast<uint8_t>(static_cast<int16_t>(z_index) + 128);
+
+    keys.push_back(
+      (static_cast<uint64_t>(layer) << 56) |
+      (biased_z << 48) |
+      (static_cast<uint64_t>(command.texture_page) << 32) |
+      sequence
+    );
+    commands.push_back(command);
+  }
+
+  uint32_t size() const { return static_cast<uint32_t>(keys.size()); }
+
+  // After sort(), the i-th command to draw
+  const RenderCommand& operator[](uint32_t i) const { return commands[keys[i] & 0xFFFFFFFF]; }
+
+  void sort() {
+    const uint32_t count = size();
+    if (count < 2) return;
+
+    // All 8 histograms in one read of the keys
+    uint32_t histograms[8][256];
+    std::memset(histograms, 0, sizeof(histograms));
+
+    for (uint32_t i = 0; i < count; i++) {
+      const uint64_t key = keys[i];
+      for (uint32_t byte = 0; byte < 8; byte++)
+        histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+    }
+
+    scratch.resize(count);
+
+    for (uint32_t byte = 0; byte < 8; byte++) {
+      uint32_t* histogram = histograms[byte];
+      const uint32_t shift = byte * 8;
+
+      // Every key has the same value here, the pass wouldn't move anything
+      if (histogram[(keys[0] >> shift) & 0xFF] == count)
+        continue;
+
+      uint32_t offset = 0;
+      for (uint32_t bucket = 0; bucket < 256; bucket++) {
+        const uint32_t bucket_size = histogram[bucket];
+        histogram[bucket] = offset;
+        offset += bucket_size;
+      }
+
+      for (uint32_t i = 0; i < count; i++)
+        scratch[histogram[(keys[i] >> shift) & 0xFF]++] = keys[i];
+
+      keys.swap(scratch);
+    }
+  }
+
+private:
+  std::vector<RenderCommand> commands;
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> scratch;
+};
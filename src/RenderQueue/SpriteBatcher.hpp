@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../AssetManager/AssetManager.hpp"
+#include "../Logger/Logger.hpp"
+#include "./RenderQueue.hpp"
+
+///////////////////////////////////////////////////////////////
+// Draws a sorted RenderQueue with one SDL_RenderGeometry call
+// per run of commands sharing a texture page, instead of one
+// SDL_RenderCopyEx per sprite. Each sprite becomes a quad:
+// rotation about the centre and flips are done here on the
+// CPU, the same way RenderCopyEx would do them.
+//
+// SDL older than 2.0.18 has no RenderGeometry, and a renderer
+// can refuse it at runtime. Either way the batcher drops back
+// to RenderCopyEx per sprite for good.
+///////////////////////////////////////////////////////////////
+class SpriteBatcher {
+public:
+  void draw(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const RenderQueue& render_queue) {
+    uint32_t run_begin = 0;
+
+    while (run_begin < render_queue.size()) {
+      const uint16_t texture_page = render_queue[run_begin].texture_page;
+      uint32_t run_end = run_begin + 1;
+      while (run_end < render_queue.size() && render_queue[run_end].texture_page == texture_page)
+        run_end++;
+
+      if (!use_geometry || !draw_run(renderer, asset_manager, render_queue, run_begin, run_end))
+        draw_run_fallback(renderer, asset_manager, render_queue, run_begin, run_end);
+
+      run_begin = run_end;
+    }
+  }
+
+  void set_use_geometry(bool enabled) { use_geometry = enabled && GEOMETRY_SUPPORTED; }
+  bool is_using_geometry() const { return use_geometry; }
+
+private:
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  const static bool GEOMETRY_SUPPORTED = true;
+#else
+  const static bool GEOMETRY_SUPPORTED = false;
+#endif
+
+  bool use_geometry = GEOMETRY_SUPPORTED;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<SDL_Vertex> vertices;
+#endif
+  std::vector<int> indices;
+
+  bool draw_run(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const RenderQueue& render_queue, uint32_t begin, uint32_t end) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const uint16_t texture_page = render_queue[begin].texture_page;
+    const SDL_Point texture_size = asset_manager->get_page_size(texture_page);
+    if (texture_size.x <= 0 || texture_size.y <= 0) return false;
+
+    const float inverse_width = 1.0f / texture_size.x;
+    const float inverse_height = 1.0f / texture_size.y;
+    const SDL_Color white = {255, 255, 255, 255};
+
+    vertices.clear();
+    for (uint32_t i = begin; i < end; i++) {
+      const auto& command = render_queue[i];
+
+      // RenderCopyEx clips the source to the texture and stretches what's
+      // left over the whole destination, do the same
+      const int src_x0 = std::max(command.src_rect.x, 0);
+      const int src_y0 = std::max(command.src_rect.y, 0);
+      const int src_x1 = std::min(command.src_rect.x + command.src_rect.w, texture_size.x);
+      const int src_y1 = std::min(command.src_rect.y + command.src_rect.h, texture_size.y);
+      if (src_x1 <= src_x0 || src_y1 <= src_y0) continue;
+
+      float u0 = src_x0 * inverse_width;
+      float v0 = src_y0 * inverse_height;
+      float u1 = src_x1 * inverse_width;
+      float v1 = src_y1 * inverse_height;
+      if (command.flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+      if (command.flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+      const float half_w = command.dst_rect.w * 0.5f;
+      const float half_h = command.dst_rect.h * 0.5f;
+      const float center_x = command.dst_rect.x + half_w;
+      const float center_y = command.dst_rect.y + half_h;
+
+      // Clockwise in degrees, y pointing down, same as RenderCopyEx
+      float cos_angle = 1.0f;
+      float sin_angle = 0.0f;
+      if (command.rotation != 0.0f) {
+        const float radians = command.rotation * static_cast<float>(M_PI) / 180.0f;
+        cos_angle = std::cos(radians);
+        sin_angle = std::sin(radians);
+      }
+
+      const float corner_x[4] = {-half_w, half_w, half_w, -half_w};
+      const float corner_y[4] = {-half_h, -half_h, half_h, half_h};
+      const float corner_u[4] = {u0, u1, u1, u0};
+      const float corner_v[4] = {v0, v0, v1, v1};
+
+      for (uint32_t corner = 0; corner < 4; corner++) {
+        vertices.push_back({
+          {center_x + corner_x[corner] * cos_angle - corner_y[corner] * sin_angle,
+           center_y + corner_x[corner] * sin_angle + corner_y[corner] * cos_angle},
+          white,
+          {corner_u[corner], corner_v[corner]}
+        });
+      }
+    }
+
+    const uint32_t num_of_quads = static_cast<uint32_t>(vertices.size() / 4);
+    if (num_of_quads == 0) return true;
+
+    for (uint32_t quad = static_cast<uint32_t>(indices.size() / 6); quad < num_of_quads; quad++) {
+      const int first = static_cast<int>(quad * 4);
+      indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    if (SDL_RenderGeometry(renderer, asset_manager->get_page_texture(texture_page),
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(num_of_quads * 6)) != 0) {
+      Logger::Warn(std::string("SDL_RenderGeometry failed, falling back to RenderCopyEx: ") + SDL_GetError());
+      use_geometry = false;
+      return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void draw_run_fallback(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const RenderQueue& render_queue, uint32_t begin, uint32_t end) {
+    SDL_Texture* texture = asset_manager->get_page_texture(render_queue[begin].texture_page);
+
+    for (uint32_t i = begin; i < end; i++) {
+      const auto& command = render_queue[i];
+      SDL_RenderCopyEx(renderer, texture, &command.src_rect, &command.dst_rect, command.rotation, NULL, command.flip);
+    }
+  }
+};
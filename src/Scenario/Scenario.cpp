@@ -0,0 +1,88 @@
+#include "./Scenario.hpp"
+#include "../Logger/Logger.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+
+static std::string trim(const std::string& text) {
+  const size_t begin = text.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) return "";
+  const size_t end = text.find_last_not_of(" \t\r");
+  return text.substr(begin, end - begin + 1);
+}
+
+// Whole string has to be a number within [0, max]
+static bool parse_number(const std::string& text, unsigned long max, unsigned long& value) {
+  if (text.empty() || text[0] == '-') return false;
+  char* end = nullptr;
+  errno = 0;
+  value = std::strtoul(text.c_str(), &end, 10);
+  return errno == 0 && *end == '\0' && value <= max;
+}
+
+bool load_scenario(const std::string& scenario_path, Scenario& scenario) {
+  std::ifstream scenario_file(scenario_path);
+  if (!scenario_file) {
+    Logger::Err("Failed opening scenario " + scenario_path);
+    return false;
+  }
+
+  const size_t name_begin = scenario_path.find_last_of('/') + 1;
+  scenario.name = scenario_path.substr(name_begin, scenario_path.find_last_of('.') - name_begin);
+
+  std::string line;
+  uint32_t line_number = 0;
+
+  while (std::getline(scenario_file, line)) {
+    line_number++;
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty()) continue;
+
+    const size_t separator = line.find('=');
+    const std::string key = trim(line.substr(0, separator));
+    const std::string value = separator == std::string::npos ? "" : trim(line.substr(separator + 1));
+    const std::string where = scenario_path + ":" + std::to_string(line_number);
+
+    if (separator == std::string::npos || key.empty()) {
+      Logger::Err(where + " isn't key = value");
+      return false;
+    }
+
+    if (key == "name") {
+      scenario.name = value;
+      continue;
+    }
+
+    unsigned long number = 0;
+    bool is_valid = true;
+
+    if (key == "level") { is_valid = parse_number(value, 2, number) && number > 0; scenario.level = static_cast<int>(number); }
+    else if (key == "ships") { is_valid = parse_number(value, UINT32_MAX, number); scenario.ships = number; }
+    else if (key == "emitters") { is_valid = parse_number(value, UINT32_MAX, number); scenario.emitters = number; }
+    else if (key == "bullet_patterns") { is_valid = parse_number(value, UINT32_MAX, number); scenario.bullet_patterns = number; }
+    else if (key == "pattern_bullets") { is_valid = parse_number(value, UINT16_MAX, number); scenario.pattern_bullets = number; }
+    else if (key == "pattern_repeat_ms") { is_valid = parse_number(value, UINT32_MAX, number) && number > 0; scenario.pattern_repeat_ms = number; }
+    else if (key == "map_width") { is_valid = parse_number(value, UINT16_MAX, number) && number > 0; scenario.map_width = number; }
+    else if (key == "map_height") { is_valid = parse_number(value, UINT16_MAX, number) && number > 0; scenario.map_height = number; }
+    else if (key == "frames") { is_valid = parse_number(value, UINT32_MAX, number) && number > 0; scenario.frames = number; }
+    else if (key == "tick_rate") { is_valid = parse_number(value, UINT16_MAX, number) && number > 0; scenario.tick_rate = number; }
+    else if (key == "width") { is_valid = parse_number(value, UINT16_MAX, number) && number > 0; scenario.width = number; }
+    else if (key == "height") { is_valid = parse_number(value, UINT16_MAX, number) && number > 0; scenario.height = number; }
+    else if (key == "seed") { is_valid = parse_number(value, UINT32_MAX, number); scenario.seed = number; }
+    else {
+      Logger::Err(where + " unknown key [" + key + "]");
+      return false;
+    }
+
+    if (!is_valid) {
+      Logger::Err(where + " bad value [" + value + "] for " + key);
+      return false;
+    }
+  }
+
+  if (scenario.emitters > scenario.ships) {
+    Logger::Err("Scenario " + scenario_path + " has more emitters than ships");
+    return false;
+  }
+  return true;
+}
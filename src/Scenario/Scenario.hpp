@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////
+// A reproducible load to run the engine under: a level plus a
+// number of extra ships, emitters and bullet patterns spread
+// over a map of a given size, placed from a fixed seed.
+//
+// Read from a key=value text file, one per line, # comments:
+//
+//   ships = 200            enemy ships with colliders and health
+//   emitters = 50          how many of them fire projectiles
+//   bullet_patterns = 10   bullet-hell rings, pattern_bullets per burst
+//   map_width = 4096
+//
+// Keys left out keep the defaults below.
+///////////////////////////////////////////////////////////////
+struct Scenario {
+  std::string name;
+  int level = 1;
+  uint32_t ships = 0;
+  uint32_t emitters = 0;
+  uint32_t bullet_patterns = 0;
+  uint16_t pattern_bullets = 32;
+  uint32_t pattern_repeat_ms = 250;
+  uint16_t map_width = 2800;
+  uint16_t map_height = 2240;
+  // Frames to run, each one fixed tick of 1 / tick_rate seconds
+  uint32_t frames = 600;
+  uint16_t tick_rate = 120;
+  uint16_t width = 1280;
+  uint16_t height = 720;
+  uint32_t seed = 1337;
+};
+
+// Logs and returns false on a missing file, an unknown key or a bad value.
+// The name defaults to the file name without its extension
+bool load_scenario(const std::string& scenario_path, Scenario& scenario);
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////
+// Game time, as opposed to wall time. Advanced once per
+// simulation tick by the tick's delta time, scaled by the time
+// scale and frozen while paused, so everything reading it
+// (projectile lifetimes, emitter rates, animations) slows
+// down, speeds up and pauses together.
+//
+// Starts at 0 when the registry is made, and only moves when
+// ticked, so a headless run with a fixed delta is repeatable.
+///////////////////////////////////////////////////////////////
+class SimulationClock {
+public:
+  SimulationClock() = default;
+  ~SimulationClock() = default;
+
+  // Returns the scaled delta time the tick should simulate
+  double tick(double delta_time) {
+    const double scaled_delta_time = is_paused ? 0.0 : delta_time * time_scale;
+    elapsed_seconds += scaled_delta_time;
+    ticks = static_cast<uint32_t>(elapsed_seconds * 1000.0);
+    return scaled_delta_time;
+  }
+
+  // Milliseconds of game time, drop-in for SDL_GetTicks()
+  uint32_t get_ticks() const { return ticks; }
+  double get_seconds() const { return elapsed_seconds; }
+
+  void set_time_scale(double scale) { time_scale = (scale < 0.0) ? 0.0 : scale; }
+  double get_time_scale() const { return time_scale; }
+
+  void pause() { is_paused = true; }
+  void resume() { is_paused = false; }
+  bool paused() const { return is_paused; }
+
+private:
+  double elapsed_seconds = 0.0;
+  double time_scale = 1.0;
+  uint32_t ticks = 0;
+  bool is_paused = false;
+};
@@ -2,7 +2,6 @@
 #include "../Components/AnimationComponent.hpp"
 #include "../Components/SpriteComponent.hpp"
 #include "../ECS/ECS.hpp"
-#include <SDL2/SDL_timer.h>
 
 class AnimationSystem : public System {
   public:
@@ -12,12 +11,14 @@ class AnimationSystem : public System {
     }
     ~AnimationSystem() = default;
 
-    void Update() {
+    void Update(const std::unique_ptr<Registry>& registry) {
+      const uint32_t now = registry->get_clock().get_ticks();
+
       for (auto& entity: get_system_entities()) {
         auto& animation = entity.get_component<AnimationComponent>();
         auto& sprite = entity.get_component<SpriteComponent>();
 
-        animation.current_frame = ((SDL_GetTicks() - animation.start_time) * animation.frame_speed / 1000) % animation.num_of_frames; // milliseconds
+        animation.current_frame = ((now - animation.start_time) * animation.frame_speed / 1000) % animation.num_of_frames; // milliseconds
         sprite.src_rect.x = animation.current_frame * sprite.width;
     }
   }
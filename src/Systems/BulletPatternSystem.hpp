@@ -0,0 +1,74 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../Components/BulletPatternComponent.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/SpriteComponent.hpp"
+#include "../TimingWheel/TimingWheel.hpp"
+#include "./BulletSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+class BulletPatternSystem : public System {
+public:
+  BulletPatternSystem() {
+    require_component<BulletPatternComponent>();
+    require_component<TransformComponent>();
+  }
+
+  // Same as ProjectileEmitterSystem, each pattern is only looked at
+  // when its next burst is due
+  void add_entity_to_system(Entity entity) override {
+    System::add_entity_to_system(entity);
+
+    const auto& pattern = entity.get_component<BulletPatternComponent>();
+    if (pattern.repeat_speed > 0)
+      emission_timers.schedule(pattern.last_emission_time + pattern.repeat_speed + 1, entity);
+  }
+
+  void Update(const std::unique_ptr<Registry>& registry) {
+    const uint32_t now = registry->get_clock().get_ticks();
+
+    due_patterns.clear();
+    emission_timers.advance(now, due_patterns);
+
+    auto& bullet_system = registry->get_system<BulletSystem>();
+
+    for (auto& entity: due_patterns) {
+      // Already destroyed, or the id now belongs to something newer
+      if (!entity.has_component<BulletPatternComponent>() || !entity.has_component<TransformComponent>())
+        continue;
+
+      auto& pattern = entity.get_component<BulletPatternComponent>();
+      const auto& transform = entity.get_component<TransformComponent>();
+
+      if (pattern.repeat_speed == 0 || now - pattern.last_emission_time <= pattern.repeat_speed)
+        continue;
+
+      glm::vec2 center = transform.position;
+      if (entity.has_component<SpriteComponent>()) {
+        const auto& sprite = entity.get_component<SpriteComponent>();
+        center.x += sprite.width * transform.scale.x / 2;
+        center.y += sprite.height * transform.scale.y / 2;
+      }
+
+      const float step = 2.0f * static_cast<float>(M_PI) / std::max<uint16_t>(pattern.num_of_bullets, 1);
+      const float start = glm::radians(pattern.angle);
+
+      for (uint16_t i = 0; i < pattern.num_of_bullets; i++) {
+        const float angle = start + step * i;
+        const glm::vec2 velocity(std::cos(angle) * pattern.bullet_speed, std::sin(angle) * pattern.bullet_speed);
+
+        if (!bullet_system.spawn(center, velocity, pattern.bullet_duration, pattern.damage, pattern.is_friendly))
+          break;
+      }
+
+      pattern.angle = std::fmod(pattern.angle + pattern.spin, 360.0f);
+      pattern.last_emission_time = now;
+      emission_timers.schedule(now + pattern.repeat_speed + 1, entity);
+    }
+  }
+
+private:
+  TimingWheel<Entity> emission_timers;
+  std::vector<Entity> due_patterns;
+};
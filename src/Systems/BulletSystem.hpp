@@ -0,0 +1,95 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/BoxColliderComponent.hpp"
+#include "../Components/HealthComponent.hpp"
+#include "../EventManager/EventManager.hpp"
+#include "../Events/BulletHitEvent.hpp"
+#include "../Bullets/BulletBuffer.hpp"
+#include "../Bullets/TargetGrid.hpp"
+#include "../Game/Game.hpp"
+
+// Bullets are drawn and collide as BULLET_SIZE x BULLET_SIZE boxes,
+// same as the projectile entities
+const static float BULLET_SIZE = 4.0f;
+const static uint32_t MAX_BULLETS = 131072;
+
+///////////////////////////////////////////////////////////////
+// Bullet-hell projectiles, for patterns with far more bullets
+// than could each be an entity. The bullets live in a
+// BulletBuffer, the system's entities are what they can hit
+// (anything with a collider and health).
+//
+// A hit works like a projectile hitting in DamageSystem:
+// friendly bullets only hit enemies, the rest only hit the
+// player, and the bullet is used up either way. DamageSystem
+// gets a BulletHitEvent and applies the damage.
+///////////////////////////////////////////////////////////////
+class BulletSystem : public System {
+public:
+  BulletSystem() {
+    require_component<TransformComponent>();
+    require_component<BoxColliderComponent>();
+    require_component<HealthComponent>();
+    bullets.reserve(MAX_BULLETS);
+  }
+  ~BulletSystem() = default;
+
+  // duration is in ms like ProjectileComponent, returns false once full
+  bool spawn(glm::vec2 position, glm::vec2 velocity, uint16_t duration, uint16_t damage, bool is_friendly) {
+    if (bullets.size() >= MAX_BULLETS) return false;
+
+    bullets.add(position.x, position.y, velocity.x, velocity.y, duration / 1000.0f, damage, is_friendly);
+    return true;
+  }
+
+  void Update(std::unique_ptr<EventManager>& event_manager, double delta_time) {
+    bullets.integrate(static_cast<float>(delta_time));
+
+    const auto targets = get_system_entities();
+    build_target_grid(targets);
+
+    if (!targets.empty()) {
+      for (uint32_t i = 0; i < bullets.size(); i++) {
+        const bool is_friendly = bullets.is_friendly[i];
+        const int32_t target = grid.query(bullets.position_x[i], bullets.position_y[i], BULLET_SIZE, is_friendly);
+        if (target == TargetGrid::NO_TARGET) continue;
+
+        event_manager->emit_event<BulletHitEvent>(targets[target], bullets.damage[i], is_friendly);
+        bullets.kill(i);
+      }
+    }
+
+    bullets.remove_expired(Game::map_width, Game::map_height);
+  }
+
+  const BulletBuffer& get_bullets() const { return bullets; }
+  uint32_t get_num_of_bullets() const { return bullets.size(); }
+
+private:
+  BulletBuffer bullets;
+  TargetGrid grid;
+
+  void build_target_grid(const std::vector<Entity>& targets) {
+    grid.reset(Game::map_width, Game::map_height, BULLET_SIZE);
+
+    for (uint32_t i = 0; i < targets.size(); i++) {
+      const auto& entity = targets[i];
+
+      // Same sides as DamageSystem, anything else just gets passed through
+      bool hit_by_friendly;
+      if (entity.has_tag("player")) hit_by_friendly = false;
+      else if (entity.belongs_to_group("enemy")) hit_by_friendly = true;
+      else continue;
+
+      const auto& collider = entity.get_component<BoxColliderComponent>();
+      const auto& transform = entity.get_component<TransformComponent>();
+      const float x = transform.position.x + collider.offset.x;
+      const float y = transform.position.y + collider.offset.y;
+
+      grid.add(i, x, y, x + collider.width * transform.scale.x, y + collider.height * transform.scale.y, hit_by_friendly);
+    }
+
+    grid.build();
+  }
+};
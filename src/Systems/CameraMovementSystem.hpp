@@ -11,15 +11,17 @@ public:
    require_component<TransformComponent>();
   }
 
-  void Update(SDL_Rect& camera) {
+  // Follows the interpolated position, the same one the sprite is drawn at
+  void Update(SDL_Rect& camera, float alpha) {
     for (const auto& entity: get_system_entities()) {
       const auto& transform = entity.get_component<TransformComponent>();
+      const glm::vec2 position = transform.interpolated_position(alpha);
       
-      if (transform.position.x + (camera.w / 2) < Game::map_width)
-        camera.x = transform.position.x - (Game::WINDOW_WIDTH / 2);
+      if (position.x + (camera.w / 2) < Game::map_width)
+        camera.x = position.x - (Game::WINDOW_WIDTH / 2);
 
-      if (transform.position.y + (camera.h / 2) < Game::map_height)
-        camera.y = transform.position.y - (Game::WINDOW_HEIGHT / 2);
+      if (position.y + (camera.h / 2) < Game::map_height)
+        camera.y = position.y - (Game::WINDOW_HEIGHT / 2);
 
       // Keep cam rect view inside screen limits
       camera.x = (camera.x < 0) ? 0 : camera.x;
@@ -3,8 +3,60 @@
 #include "../Components/BoxColliderComponent.hpp"
 #include "../Components/TransformComponent.hpp"
 #include "../Components/CollisionComponent.hpp"
+#include "../Components/RigidBodyComponent.hpp"
+#include "../Components/ProjectileComponent.hpp"
 #include "../EventManager/EventManager.hpp"
-#include "../Events/CollisionEvent.hpp"
+#include "../Events/CollisionEnterEvent.hpp"
+#include "../Events/CollisionStayEvent.hpp"
+#include "../Events/CollisionExitEvent.hpp"
+#include "../Collision/ColliderBounds.hpp"
+#include "../Collision/AABBKernel.hpp"
+#include "../Collision/SweptAABB.hpp"
+#include "../Collision/TileCollision.hpp"
+#include "../Tilemap/Tilemap.hpp"
+#include "../ThreadPool/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+///////////////////////////////////////////////////////////////
+// Contacts persist between frames, keyed by the entity pair.
+// Comparing this frame's overlaps against last frame's gives
+// the transitions, so a pair emits one CollisionEnterEvent,
+// a CollisionStayEvent per frame only for those listening to
+// it, and one CollisionExitEvent when it separates.
+//
+// Every contact carries the shortest move that separates the
+// pair, so a listener can push one of them back out instead of
+// only reacting to the first frame.
+//
+// Projectiles are swept over the frame's movement so a bullet
+// that jumps over a collider on a slow frame still hits it.
+//
+// The broadphase and narrowphase only read the SoA bounds, so
+// they run in chunks of boxes on the thread pool. Each chunk
+// fills its own hit buffer and the buffers are appended in
+// chunk order, giving the same hits as running serially.
+//
+// Solid tiles of the tilemap aren't entities, every collider
+// is tested against the tile bitmask and a hit is reported as
+// a contact with one stand-in "tilemap" entity, so listeners
+// treat the level geometry like any other object. Its separation
+// moves the collider clear of the solid tiles it overlaps.
+///////////////////////////////////////////////////////////////
+struct PairHit {
+  uint32_t lhs;
+  uint32_t rhs;
+  float time_of_impact;
+};
+
+struct Contact {
+  uint64_t key;
+  Entity lhs;
+  Entity rhs;
+  float time_of_impact;
+  glm::vec2 separation;
+};
 
 class CollisionSystem : public System {
 public:
@@ -15,24 +67,198 @@ public:
   }
   ~CollisionSystem() = default;
 
-  void Update(std::unique_ptr<EventManager>& event_manager) {
+  // Removed entities never get an exit event, so drop their contacts
+  // here, before the id can be handed out again
+  void remove_entity_from_system(Entity entity) override {
+    System::remove_entity_from_system(entity);
+
+    const auto entity_id = entity.get_entity_id();
+    auto first_removed = std::remove_if(contacts.begin(), contacts.end(), [&](const Contact& contact) {
+      if (contact.lhs.get_entity_id() != entity_id && contact.rhs.get_entity_id() != entity_id)
+        return false;
+
+      remove_contact(contact.lhs.get_entity_id() == entity_id ? contact.rhs : contact.lhs);
+      return true;
+    });
+
+    if (first_removed != contacts.end()) {
+      auto& collision = entity.get_component<CollisionComponent>();
+      collision.num_of_contacts = 0;
+      collision.is_colliding = false;
+      contacts.erase(first_removed, contacts.end());
+    }
+  }
+
+  void Update(std::unique_ptr<EventManager>& event_manager, std::unique_ptr<ThreadPool>& thread_pool, double delta_time) {
     auto entities = get_system_entities();
-    
-    for (auto i = entities.begin(); i != entities.end(); i++) {
-        auto& collider = i->get_component<BoxColliderComponent>();
-        auto& transform = i->get_component<TransformComponent>();
-
-        for (auto j = i + 1; j != entities.end(); j++) {
-            auto& rhs_collider = j->get_component<BoxColliderComponent>();
-            auto& rhs_transform = j->get_component<TransformComponent>();
-
-            if (transform.position.x + collider.offset.x < rhs_transform.position.x + (rhs_collider.width * rhs_transform.scale.x) &&
-                transform.position.x + collider.offset.x + (collider.width * transform.scale.x) > rhs_transform.position.x &&
-                transform.position.y + collider.offset.y < rhs_transform.position.y + (rhs_collider.height * rhs_transform.scale.y) &&
-                transform.position.y + collider.offset.y + (collider.height * transform.scale.y) > rhs_transform.position.y) {
-                  event_manager->emit_event<CollisionEvent>(*i, *j);
-            }
-        }
+
+    update_bounds(entities, delta_time);
+
+    // Small scenes aren't worth waking the workers for
+    const uint32_t num_of_boxes = bounds.size();
+    uint32_t num_of_chunks = 1;
+    if (num_of_boxes >= MIN_BOXES_FOR_THREADS && thread_pool->get_num_of_threads() > 1)
+      num_of_chunks = std::min(num_of_boxes / MIN_BOXES_PER_CHUNK, thread_pool->get_num_of_threads() * CHUNKS_PER_THREAD);
+
+    if (chunk_pairs.size() < num_of_chunks) {
+      chunk_pairs.resize(num_of_chunks);
+      chunk_hits.resize(num_of_chunks);
+    }
+
+    thread_pool->parallel_for(num_of_chunks, [&](uint32_t chunk) {
+      const uint32_t begin = static_cast<uint64_t>(num_of_boxes) * chunk / num_of_chunks;
+      const uint32_t end = static_cast<uint64_t>(num_of_boxes) * (chunk + 1) / num_of_chunks;
+      narrowphase(begin, end, chunk_pairs[chunk], chunk_hits[chunk]);
+    });
+
+    current_contacts.clear();
+    for (uint32_t chunk = 0; chunk < num_of_chunks; chunk++)
+      for (const auto& hit: chunk_hits[chunk])
+        add_current_contact(entities[bounds.index[hit.lhs]], entities[bounds.index[hit.rhs]], hit.time_of_impact, separation(hit.lhs, hit.rhs));
+
+    if (tilemap && tilemap->is_loaded() && tilemap_entity) {
+      const float tile_world_size = static_cast<float>(tilemap->get_tile_world_size());
+      glm::vec2 separation;
+      for (uint32_t slot = 0; slot < num_of_boxes; slot++) {
+        if (TileCollision::separation(tilemap->get_file(), tile_world_size, bounds.min_x[slot], bounds.min_y[slot], bounds.max_x[slot], bounds.max_y[slot], separation.x, separation.y))
+          add_current_contact(entities[bounds.index[slot]], *tilemap_entity, 1.0f, separation);
+      }
+    }
+    std::sort(current_contacts.begin(), current_contacts.end(), [](const Contact& a, const Contact& b) {
+      return a.key < b.key;
+    });
+
+    // Both lists are sorted by key, one merge pass finds every transition
+    auto previous = contacts.begin();
+    auto current = current_contacts.begin();
+
+    while (previous != contacts.end() || current != current_contacts.end()) {
+      if (current == current_contacts.end() || (previous != contacts.end() && previous->key < current->key)) {
+        remove_contact(previous->lhs);
+        remove_contact(previous->rhs);
+        event_manager->emit_event<CollisionExitEvent>(previous->lhs, previous->rhs);
+        previous++;
+      }
+      else if (previous == contacts.end() || current->key < previous->key) {
+        add_contact(current->lhs);
+        add_contact(current->rhs);
+        event_manager->emit_event<CollisionEnterEvent>(current->lhs, current->rhs, current->time_of_impact, current->separation);
+        current++;
+      }
+      else {
+        event_manager->emit_event<CollisionStayEvent>(current->lhs, current->rhs, current->separation);
+        previous++;
+        current++;
+      }
+    }
+
+    contacts.swap(current_contacts);
+  }
+
+  uint32_t get_num_of_contacts() const { return static_cast<uint32_t>(contacts.size()); }
+
+  // Static collision layer, tile hits are contacts with tilemap_entity
+  // (which needs a CollisionComponent for the contact count)
+  void set_tilemap(const Tilemap* tilemap, Entity tilemap_entity) {
+    this->tilemap = tilemap;
+    this->tilemap_entity = tilemap_entity;
+  }
+
+private:
+  const static uint32_t MIN_BOXES_FOR_THREADS = 512;
+  const static uint32_t MIN_BOXES_PER_CHUNK = 128;
+  const static uint32_t CHUNKS_PER_THREAD = 4;
+
+  ColliderBounds bounds;
+  std::vector<std::vector<CollisionPair>> chunk_pairs;
+  std::vector<std::vector<PairHit>> chunk_hits;
+  std::vector<Contact> contacts;
+  std::vector<Contact> current_contacts;
+  const Tilemap* tilemap = nullptr;
+  std::optional<Entity> tilemap_entity;
+
+  // Runs on the workers, must only touch the bounds and its own buffers
+  void narrowphase(uint32_t begin, uint32_t end, std::vector<CollisionPair>& pairs, std::vector<PairHit>& hits) const {
+    pairs.clear();
+    hits.clear();
+    AABBKernel::sweep_and_prune(bounds, pairs, begin, end);
+
+    for (const auto& pair: pairs) {
+      // The swept box only makes it a candidate, the sweep decides the hit
+      float time_of_impact = 1.0f;
+      if (bounds.is_swept(pair.lhs) || bounds.is_swept(pair.rhs)) {
+        time_of_impact = SweptAABB::time_of_impact(bounds, pair.lhs, pair.rhs);
+        if (time_of_impact < 0.0f) continue;
       }
+
+      hits.push_back({pair.lhs, pair.rhs, time_of_impact});
     }
+  }
+
+  // Shortest move along one axis that takes the lhs box out of the rhs box
+  glm::vec2 separation(uint32_t lhs, uint32_t rhs) const {
+    const float left = bounds.max_x[lhs] - bounds.min_x[rhs];
+    const float right = bounds.max_x[rhs] - bounds.min_x[lhs];
+    const float up = bounds.max_y[lhs] - bounds.min_y[rhs];
+    const float down = bounds.max_y[rhs] - bounds.min_y[lhs];
+
+    const float x = (left < right) ? -left : right;
+    const float y = (up < down) ? -up : down;
+    return (std::abs(x) < std::abs(y)) ? glm::vec2(x, 0) : glm::vec2(0, y);
+  }
+
+  // Lower id on the left, a pair has the same key whichever way it was found.
+  // separation moves lhs out of rhs, so it flips with the pair
+  void add_current_contact(const Entity& lhs, const Entity& rhs, float time_of_impact, const glm::vec2& separation) {
+    if (lhs.get_entity_id() < rhs.get_entity_id())
+      current_contacts.push_back({make_key(lhs, rhs), lhs, rhs, time_of_impact, separation});
+    else
+      current_contacts.push_back({make_key(rhs, lhs), rhs, lhs, time_of_impact, -separation});
+  }
+
+  static uint64_t make_key(const Entity& lhs, const Entity& rhs) {
+    return (static_cast<uint64_t>(lhs.get_entity_id()) << 32) | rhs.get_entity_id();
+  }
+
+  static void add_contact(const Entity& entity) {
+    auto& collision = entity.get_component<CollisionComponent>();
+    collision.num_of_contacts++;
+    collision.is_colliding = true;
+  }
+
+  static void remove_contact(const Entity& entity) {
+    auto& collision = entity.get_component<CollisionComponent>();
+    if (collision.num_of_contacts > 0)
+      collision.num_of_contacts--;
+    collision.is_colliding = collision.num_of_contacts > 0;
+  }
+
+  // Per frame stage: world-space box of each collider, written once
+  // instead of being recomputed inside the pair loop
+  void update_bounds(const std::vector<Entity>& entities, double delta_time) {
+    bounds.clear();
+    bounds.reserve(entities.size());
+
+    for (uint32_t i = 0; i < entities.size(); i++) {
+      const auto& entity = entities[i];
+      const auto& collider = entity.get_component<BoxColliderComponent>();
+      const auto& transform = entity.get_component<TransformComponent>();
+
+      // MovementSystem already moved it by velocity * dt this frame
+      glm::vec2 displacement(0);
+      if (entity.has_component<ProjectileComponent>() && entity.has_component<RigidBodyComponent>())
+        displacement = entity.get_component<RigidBodyComponent>().velocity * static_cast<float>(delta_time);
+
+      bounds.add_swept(i,
+        transform.position.x + collider.offset.x,
+        transform.position.y + collider.offset.y,
+        collider.width * transform.scale.x,
+        collider.height * transform.scale.y,
+        displacement.x,
+        displacement.y
+      );
+    }
+
+    bounds.sort_by_min_x();
+  }
 };
@@ -7,7 +7,8 @@
 #include "../Components/HealthComponent.hpp"
 #include "../Components/GodModeComponent.hpp"
 #include "../EventManager/EventManager.hpp"
-#include "../Events/CollisionEvent.hpp"
+#include "../Events/CollisionEnterEvent.hpp"
+#include "../Events/BulletHitEvent.hpp"
 #include "../Logger/Logger.hpp"
 
 class DamageSystem: public System {
@@ -19,13 +20,15 @@ public:
 
   void ListenForEvents(std::unique_ptr<EventManager>& event_manager) {
     event_manager->listen_for_event(this, &DamageSystem::onCollision);
+    event_manager->listen_for_event(this, &DamageSystem::onBulletHit);
   }
 
-  void onCollision(CollisionEvent& event) {
+  void onCollision(CollisionEnterEvent& event) {
     Logger::Log("DamageSystem event occured! Entities: " + std::to_string(event.lhs.get_entity_id()) + " and " + std::to_string(event.rhs.get_entity_id()) + "!");
 
-    event.lhs.get_component<CollisionComponent>().is_colliding = true;
-    event.rhs.get_component<CollisionComponent>().is_colliding = true;
+    // A projectile already spent this frame doesn't get to hit twice
+    if (event.lhs.registry->is_entity_released(event.lhs) || event.rhs.registry->is_entity_released(event.rhs))
+      return;
 
     if ( (event.lhs.belongs_to_group("projectile") && event.rhs.has_tag("player")) || (event.lhs.has_tag("player") && event.rhs.belongs_to_group("projectile")) ) 
       (event.lhs.belongs_to_group("projectile")) ? Projectile_hit_player(event.lhs, event.rhs) : Projectile_hit_player(event.rhs, event.lhs);
@@ -36,54 +39,51 @@ public:
      return;
   }
 
+  // Bullet-hell bullets are always used up by the hit, BulletSystem
+  // only reports hits on the side they can damage
+  void onBulletHit(BulletHitEvent& event) {
+    apply_damage(event.target, event.damage, event.is_friendly, event.target.has_tag("player"));
+  }
+
   void Projectile_hit_player(Entity& projectile, Entity& player) {
     Logger::Log("Projectile hit player!");
 
     const auto& projectile_component = projectile.get_component<ProjectileComponent>();
-    auto& health_component = player.get_component<HealthComponent>();
-
-    if (player.has_component<GodModeComponent>() && (!projectile_component.is_friendly)) {
-      if (player.get_component<GodModeComponent>().god_mode_enabled) {
-        Logger::Log("Player has Godmode! Ignoring projectile!");
-        projectile.remove();
-        return;
-      }
-    }
-
-    if (!projectile_component.is_friendly) {
-      health_component.health_amount -= projectile_component.damage;
-      projectile.remove();
-    }
-
-    if (health_component.health_amount <= 0) {
-      Logger::Log("Player with ID " + std::to_string(player.get_entity_id()) + " was killed!");
-      player.remove();
-    }
-
+    if (apply_damage(player, projectile_component.damage, projectile_component.is_friendly, true))
+      projectile.release();
   }
+
   void Projectile_hit_enemy(Entity& projectile, Entity& enemy) {
     Logger::Log("Projectile hit enemy!");
 
     const auto& projectile_component = projectile.get_component<ProjectileComponent>();
-    auto& health_component = enemy.get_component<HealthComponent>();
+    if (apply_damage(enemy, projectile_component.damage, projectile_component.is_friendly, false))
+      projectile.release();
+  }
 
-    if (enemy.has_component<GodModeComponent>() && (projectile_component.is_friendly)) {
-      if (enemy.get_component<GodModeComponent>().god_mode_enabled) {
-        Logger::Log("Enemy has Godmode! Ignoring projectile!");
-        projectile.remove();
-        return;
+  // Shared by projectile entities and bullets. Only hostile shots
+  // (enemy fire on the player, friendly fire on enemies) do anything,
+  // god mode soaks them up. Returns whether the shot was used up
+  bool apply_damage(Entity& target, uint16_t damage, bool is_friendly, bool target_is_player) {
+    const bool is_hostile = target_is_player ? !is_friendly : is_friendly;
+    auto& health_component = target.get_component<HealthComponent>();
+
+    if (is_hostile && target.has_component<GodModeComponent>()) {
+      if (target.get_component<GodModeComponent>().god_mode_enabled) {
+        Logger::Log(std::string(target_is_player ? "Player" : "Enemy") + " has Godmode! Ignoring projectile!");
+        return true;
       }
     }
 
-    if (projectile_component.is_friendly) {
-      health_component.health_amount -= projectile_component.damage;
-      projectile.remove();
-    }
+    if (is_hostile)
+      health_component.health_amount -= damage;
 
     if (health_component.health_amount <= 0) {
-      Logger::Log("Enemy with ID " + std::to_string(enemy.get_entity_id()) + " was killed!");
-      enemy.remove();
+      Logger::Log(std::string(target_is_player ? "Player" : "Enemy") + " with ID " + std::to_string(target.get_entity_id()) + " was killed!");
+      target.remove();
     }
+
+    return is_hostile;
   }
 
   void Update() {
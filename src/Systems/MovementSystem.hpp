@@ -1,12 +1,15 @@
 #pragma once
 #include "../ECS/ECS.hpp"
 #include "../EventManager/EventManager.hpp"
-#include "../Events/CollisionEvent.hpp"
+#include "../Events/CollisionEnterEvent.hpp"
+#include "../Events/CollisionStayEvent.hpp"
 #include "../Components/RigidBodyComponent.hpp"
 #include "../Components/TransformComponent.hpp"
 #include "../Components/CollisionComponent.hpp"
 #include "../Components/SpriteComponent.hpp"
 #include "../Game/Game.hpp"
+#include <algorithm>
+#include <cmath>
 
 const static uint8_t resolution_offset = 60; // NOTE: w/o this the borders aren't properly defined.
 
@@ -22,24 +25,42 @@ public:
 
   void ListenForEvents(const std::unique_ptr<EventManager>& event_manager) {
     event_manager->listen_for_event(this, &MovementSystem::onCollision);
+    event_manager->listen_for_event(this, &MovementSystem::onCollisionStay);
   }
 
-  void onCollision(CollisionEvent& event) {
+  void onCollision(CollisionEnterEvent& event) {
     Logger::Log("Collision event occured! Entities: " + std::to_string(event.lhs.get_entity_id()) + " and " + std::to_string(event.rhs.get_entity_id()) + "!");
 
-    event.lhs.get_component<CollisionComponent>().is_colliding = true;
-    event.rhs.get_component<CollisionComponent>().is_colliding = true;
+    if (player_hit_object(event.lhs, event.rhs, event.separation))
+      return;
 
-    if ( (event.lhs.belongs_to_group("object") && event.rhs.has_tag("player")) || (event.lhs.has_tag("player") && event.rhs.belongs_to_group("object")) ) 
-      (event.lhs.belongs_to_group("object")) ? object_hit_player(event.lhs, event.rhs) : object_hit_player(event.rhs, event.lhs);
-
-    else if ( (event.lhs.belongs_to_group("object") && event.rhs.belongs_to_group("enemy")) || (event.lhs.belongs_to_group("enemy") && event.rhs.belongs_to_group("object")) )
+    if ( (event.lhs.belongs_to_group("object") && event.rhs.belongs_to_group("enemy")) || (event.lhs.belongs_to_group("enemy") && event.rhs.belongs_to_group("object")) )
       (event.lhs.belongs_to_group("object")) ? object_hit_enemy(event.lhs, event.rhs) : object_hit_enemy(event.rhs, event.lhs);
-    else
-     return;
   }
 
-  void object_hit_player(const Entity& object, Entity& player) {
+  // Still overlapping, keep pushing the player out until it isn't
+  void onCollisionStay(CollisionStayEvent& event) {
+    player_hit_object(event.lhs, event.rhs, event.separation);
+  }
+
+  // separation moves lhs out of rhs, flipped when the player is on the right
+  bool player_hit_object(Entity& lhs, Entity& rhs, const glm::vec2& separation) {
+    if (lhs.has_tag("player") && rhs.belongs_to_group("object")) {
+      object_hit_player(rhs, lhs, separation);
+      return true;
+    }
+    if (lhs.belongs_to_group("object") && rhs.has_tag("player")) {
+      object_hit_player(lhs, rhs, -separation);
+      return true;
+    }
+    return false;
+  }
+
+  // Objects are solid, the player is put back outside and stopped
+  void object_hit_player(const Entity& object, Entity& player, const glm::vec2& separation) {
+    auto& transform = player.get_component<TransformComponent>();
+    transform.position += separation;
+
     auto& rigid_body = player.get_component<RigidBodyComponent>();
     rigid_body.velocity.x = 0;
     rigid_body.velocity.y = 0;
@@ -72,6 +93,7 @@ public:
       auto& transform = entity.get_component<TransformComponent>();
       auto& rigid_body = entity.get_component<RigidBodyComponent>();
 
+      transform.previous_position = transform.position;
       transform.position.x += rigid_body.velocity.x * delta_time;
       transform.position.y += rigid_body.velocity.y * delta_time;
 
@@ -84,8 +106,17 @@ public:
       );
 
       if ((entity_x_out_of_bounds && !entity.has_tag("player")) || (entity_y_out_of_bounds && !entity.has_tag("player"))) {
-        entity.remove();
-        Logger::Warn("Killed entity that was out of bounds!");
+        // Projectiles go back to the pool to be fired again
+        if (entity.belongs_to_group("projectile")) {
+          entity.release();
+        }
+        else if (bounce_at_edges) {
+          bounce_off_edges(transform, rigid_body, entity_x_out_of_bounds, entity_y_out_of_bounds);
+        }
+        else {
+          entity.remove();
+          Logger::Warn("Killed entity that was out of bounds!");
+        }
       }
 
       if ((entity_x_out_of_bounds && entity.has_tag("player")) || (entity_y_out_of_bounds && entity.has_tag("player"))) {
@@ -108,6 +139,23 @@ public:
     }
   }
 
+  // Scenarios keep everything on the map so the load doesn't change mid run
+  void set_bounce_at_edges(bool bounce_at_edges) { this->bounce_at_edges = bounce_at_edges; }
+
 private:
-  
+  bool bounce_at_edges = false;
+
+  // Turns the entity back towards the inside of the map
+  void bounce_off_edges(TransformComponent& transform, RigidBodyComponent& rigid_body, const bool x, const bool y) {
+    if (x) {
+      const float right_edge = Game::map_width - resolution_offset;
+      rigid_body.velocity.x = (transform.position.x >= right_edge) ? -std::abs(rigid_body.velocity.x) : std::abs(rigid_body.velocity.x);
+      transform.position.x = std::clamp(transform.position.x, 1.0f, right_edge - 1.0f);
+    }
+    if (y) {
+      const float bottom_edge = Game::map_height - resolution_offset;
+      rigid_body.velocity.y = (transform.position.y >= bottom_edge) ? -std::abs(rigid_body.velocity.y) : std::abs(rigid_body.velocity.y);
+      transform.position.y = std::clamp(transform.position.y, 1.0f, bottom_edge - 1.0f);
+    }
+  }
 };
@@ -3,8 +3,11 @@
 #include "../AssetManager/AssetManager.hpp"
 #include "../Components/MovingTextComponent.hpp"
 #include "../Components/TransformComponent.hpp"
+#include "../FramePipeline/FramePacket.hpp"
+#include "./VisibilitySystem.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_render.h>
+#include <string>
 
 class MovingTextSystem : public System {
 public:
@@ -13,29 +16,39 @@ public:
     require_component<TransformComponent>();
   }
 
-  void Update(std::unique_ptr<AssetManager>& asset_manager, SDL_Renderer* renderer, const SDL_Rect& camera) {
-    for (auto& entity: get_system_entities()) {
+  void Extract(const VisibilitySystem& visibility, const SDL_Rect& camera, float alpha, FramePacket& packet) {
+    // Labels of ships off screen aren't drawn at all
+    visibility.for_each_visible(*this, [&](const Entity& entity) {
       const auto& text = entity.get_component<MovingTextComponent>();
       const auto& transform = entity.get_component<TransformComponent>();
+      const glm::vec2 position = transform.interpolated_position(alpha);
+
+      packet.push_text(
+        packet.labels,
+        text.text,
+        static_cast<int>((position.x + text.offset_x) - camera.x),
+        static_cast<int>((position.y + text.offset_y) - camera.y),
+        text.color,
+        text.font,
+        false
+      );
+    });
+  }
 
-      SDL_Surface* surface = TTF_RenderText_Blended(asset_manager->get_font(text.asset_id), text.text.c_str(), text.color);
-      SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-      SDL_FreeSurface(surface);
-
-      int32_t text_width = 0;
-      int32_t text_height = 0;
-
-      SDL_QueryTexture(texture, NULL, NULL, &text_width, &text_height);
+  void Render(SDL_Renderer* renderer, std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+    for (const auto& command: packet.labels) {
+      packet.get_text(command, text);
 
-      SDL_Rect dst_rect {
-        static_cast<int>((transform.position.x + text.offset_x) - camera.x),
-        static_cast<int>((transform.position.y + text.offset_y) - camera.y),
-        text_width,
-        text_height
-      };
+      // Labels don't change, after the first frame this is a lookup
+      const TextTexture text_texture = asset_manager->get_text(renderer, command.font, text, command.color);
+      if (!text_texture.texture) continue;
 
-      SDL_RenderCopy(renderer, texture, NULL, &dst_rect);
+      SDL_Rect dst_rect {command.x, command.y, text_texture.width, text_texture.height};
+      SDL_RenderCopy(renderer, text_texture.texture, NULL, &dst_rect);
     }
   }
 
+private:
+  // Scratch copy of the label being drawn
+  std::string text;
 };
@@ -1,7 +1,7 @@
 #pragma once
 #include "../ECS/ECS.hpp"
 #include "../Components/ProjectileComponent.hpp"
-#include <SDL2/SDL_timer.h>
+#include "../TimingWheel/TimingWheel.hpp"
 
 class ProjectileDurationSystem : public System {
 public:
@@ -9,14 +9,37 @@ public:
     require_component<ProjectileComponent>();
   }
 
-  void Update() {
-    for (auto& entity: get_system_entities()) {
+  // Each projectile registers its expiry once, instead of being
+  // checked every frame
+  void add_entity_to_system(Entity entity) override {
+    System::add_entity_to_system(entity);
+
+    const auto& projectile = entity.get_component<ProjectileComponent>();
+    expiry_timers.schedule(projectile.start_time + projectile.duration + 1, entity);
+  }
+
+  void Update(const std::unique_ptr<Registry>& registry) {
+    const uint32_t now = registry->get_clock().get_ticks();
+
+    expired.clear();
+    expiry_timers.advance(now, expired);
+
+    for (auto& entity: expired) {
+      // Already destroyed or back in the pool, or the id now belongs to
+      // something newer
+      if (!entity.has_component<ProjectileComponent>() || entity.registry->is_entity_released(entity))
+        continue;
+
       const auto& projectile = entity.get_component<ProjectileComponent>();
 
-      if (SDL_GetTicks() - projectile.start_time > projectile.duration) {
-        entity.remove();
+      // A recycled projectile's old timer finds the new start time here
+      if (now - projectile.start_time > projectile.duration) {
+        entity.release();
       }
     }
   }
 
+private:
+  TimingWheel<Entity> expiry_timers;
+  std::vector<Entity> expired;
 };
@@ -9,10 +9,12 @@
 #include "../Components/CollisionComponent.hpp"
 #include "../Components/ProjectileComponent.hpp"
 #include "../ECS/ECS.hpp"
+#include "../TimingWheel/TimingWheel.hpp"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_timer.h>
+#include <optional>
 
-static double ms_last_frame = 0;
+// Minimum game time between player shots, will fire every frame otherwise
+const static uint32_t PLAYER_FIRE_COOLDOWN_MS = 300;
 
 class ProjectileEmitterSystem : public System {
 public:
@@ -21,17 +23,64 @@ public:
     require_component<TransformComponent>();
   }
 
+  // Repeating emitters register when they'll next fire, and re-register
+  // each time they do, so idle emitters cost nothing per frame
+  void add_entity_to_system(Entity entity) override {
+    System::add_entity_to_system(entity);
+
+    const auto& projectile_emitter = entity.get_component<ProjectileEmitterComponent>();
+    if (projectile_emitter.repeat_speed > 0)
+      emission_timers.schedule(projectile_emitter.last_emission_time + projectile_emitter.repeat_speed + 1, entity);
+  }
+
+  // Reuses a released projectile when there is one, only its per shot
+  // state is rewritten. The sprite and collider are the same for every
+  // projectile so they're left as they were
+  static void spawn_projectile(Registry& registry, glm::vec2 position, glm::vec2 velocity, const ProjectileEmitterComponent& projectile_emitter, uint32_t now) {
+    if (auto recycled = registry.acquire_entity("projectile")) {
+      Entity projectile = *recycled;
+
+      auto& transform = projectile.get_component<TransformComponent>();
+      transform.position = position;
+      transform.previous_position = position;
+      transform.scale = glm::vec2(1.0, 1.0);
+      transform.rotation = 0;
+
+      projectile.get_component<RigidBodyComponent>().velocity = velocity;
+
+      auto& collision = projectile.get_component<CollisionComponent>();
+      collision.is_colliding = false;
+      collision.num_of_contacts = 0;
+
+      auto& projectile_component = projectile.get_component<ProjectileComponent>();
+      projectile_component.is_friendly = projectile_emitter.is_friendly;
+      projectile_component.damage = projectile_emitter.damage;
+      projectile_component.duration = projectile_emitter.projectile_duration;
+      projectile_component.start_time = now;
+      return;
+    }
+
+    Entity projectile = registry.create_entity();
+    projectile.group("projectile");
+    projectile.add_component<TransformComponent>(position, glm::vec2(1.0, 1.0), 0);
+    projectile.add_component<RigidBodyComponent>(velocity);
+    projectile.add_component<SpriteComponent>("bullet-image", 4, 4, 0, 0, 3, false);
+    projectile.add_component<BoxColliderComponent>(4, 4);
+    projectile.add_component<CollisionComponent>();
+    projectile.add_component<ProjectileComponent>(projectile_emitter.is_friendly, projectile_emitter.damage, projectile_emitter.projectile_duration, now);
+  }
+
   void ListenForEvents(std::unique_ptr<EventManager>& event_manager) {
     event_manager->listen_for_event(this, &ProjectileEmitterSystem::onKeyPressed);
   }
 
   void onKeyPressed(KeyPressedEvent& event) {
-    // rate limit, will fire every frame otherwise
-    double time_since_last_bullet = (SDL_GetTicks() - ms_last_frame) / 1000;
-
-    if (event.key_pressed == SDLK_SPACE && time_since_last_bullet >= 0.30) {
+    if (event.key_pressed == SDLK_SPACE) {
       for (auto& entity: get_system_entities()) {
-        if (entity.has_tag("player")) {
+        const uint32_t now = entity.registry->get_clock().get_ticks();
+
+        const bool is_cooled_down = !last_player_emission_time || now - *last_player_emission_time >= PLAYER_FIRE_COOLDOWN_MS;
+        if (entity.has_tag("player") && is_cooled_down) {
           const auto& projectile_emitter = entity.get_component<ProjectileEmitterComponent>();
           const auto& transform = entity.get_component<TransformComponent>();
           const auto& rigid_body = entity.get_component<RigidBodyComponent>();
@@ -59,30 +108,32 @@ public:
           projectile_velocity.x = projectile_emitter.projectile_velocity.x * x_direction;
           projectile_velocity.y = projectile_emitter.projectile_velocity.y * y_direction;
 
-          Entity projectile = entity.registry->create_entity();
-          projectile.group("projectile");
-          projectile.add_component<TransformComponent>(projectile_pos, glm::vec2(1.0, 1.0), 0);
-          projectile.add_component<RigidBodyComponent>(projectile_velocity);
-          projectile.add_component<SpriteComponent>("bullet-image", 4, 4, 0, 0, 3, false);
-          projectile.add_component<BoxColliderComponent>(4, 4);
-          projectile.add_component<CollisionComponent>();
-          projectile.add_component<ProjectileComponent>(projectile_emitter.is_friendly, projectile_emitter.damage, projectile_emitter.projectile_duration);
+          spawn_projectile(*entity.registry, projectile_pos, projectile_velocity, projectile_emitter, now);
 
-          ms_last_frame = SDL_GetTicks();
+          last_player_emission_time = now;
         }
       }
     }
   }
 
   void Update(const std::unique_ptr<Registry>& registry) {
-    for (auto& entity: get_system_entities()) {
+    const uint32_t now = registry->get_clock().get_ticks();
+
+    due_emitters.clear();
+    emission_timers.advance(now, due_emitters);
+
+    for (auto& entity: due_emitters) {
+      // Already destroyed, or the id now belongs to something newer
+      if (!entity.has_component<ProjectileEmitterComponent>() || !entity.has_component<TransformComponent>())
+        continue;
+
       auto& projectile_emitter = entity.get_component<ProjectileEmitterComponent>();
       const auto& transform = entity.get_component<TransformComponent>();
 
       if (projectile_emitter.repeat_speed == 0)
         continue;
 
-      if (SDL_GetTicks() - projectile_emitter.last_emission_time > projectile_emitter.repeat_speed) {
+      if (now - projectile_emitter.last_emission_time > projectile_emitter.repeat_speed) {
         glm::vec2 projectile_pos = transform.position;
 
         if (entity.has_component<SpriteComponent>()) {
@@ -91,18 +142,18 @@ public:
           projectile_pos += (sprite.height / 2);
         }
 
-        Entity projectile = registry->create_entity();
-        projectile.group("projectile");
-        projectile.add_component<TransformComponent>(projectile_pos, glm::vec2(1.0, 1.0), 0);
-        projectile.add_component<RigidBodyComponent>(projectile_emitter.projectile_velocity);
-        projectile.add_component<SpriteComponent>("bullet-image", 4, 4, 0, 0, 3, false);
-        projectile.add_component<BoxColliderComponent>(4, 4);
-        projectile.add_component<CollisionComponent>();
-        projectile.add_component<ProjectileComponent>(projectile_emitter.is_friendly, projectile_emitter.damage, projectile_emitter.projectile_duration);
+        spawn_projectile(*registry, projectile_pos, projectile_emitter.projectile_velocity, projectile_emitter, now);
 
-        projectile_emitter.last_emission_time = SDL_GetTicks();
+        projectile_emitter.last_emission_time = now;
+        emission_timers.schedule(now + projectile_emitter.repeat_speed + 1, entity);
       }
     }
   }
 
+private:
+  // Empty until the player's first shot, which is never held back
+  std::optional<uint32_t> last_player_emission_time;
+  TimingWheel<Entity> emission_timers;
+  std::vector<Entity> due_emitters;
+
 };
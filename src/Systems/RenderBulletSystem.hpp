@@ -0,0 +1,128 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_render.h>
+#include "../ECS/ECS.hpp"
+#include "../AssetManager/AssetManager.hpp"
+#include "../Bullets/BulletBuffer.hpp"
+#include "../Logger/Logger.hpp"
+#include "./BulletSystem.hpp"
+#include "../FramePipeline/FramePacket.hpp"
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Draws every on-screen bullet with one SDL_RenderGeometry
+// call: a textured quad (4 vertices, 6 indices) per bullet.
+// The frame packet only carries each bullet's top left corner
+// on screen, the quads are built from those when rendering.
+// The index list never changes shape, so it's only grown,
+// never rebuilt.
+//
+// Without RenderGeometry (SDL older than 2.0.18, or the renderer
+// refused it) each bullet is a RenderCopy of its image instead.
+///////////////////////////////////////////////////////////////
+class RenderBulletSystem : public System {
+public:
+  RenderBulletSystem() = default;
+  ~RenderBulletSystem() = default;
+
+  void Extract(const std::unique_ptr<AssetManager>& asset_manager, const SDL_Rect& camera, const BulletBuffer& bullets, float alpha, FramePacket& packet) {
+    if (!asset_manager->has_texture(bullet_texture)) return;
+    packet.bullet_texture_page = asset_manager->get_texture_page(bullet_texture);
+
+    // Blend back towards where they were last tick, same as
+    // TransformComponent::interpolated_position
+    const float rewind = (1.0f - alpha) * bullets.last_step;
+    const float left = static_cast<float>(camera.x);
+    const float top = static_cast<float>(camera.y);
+    const float right = left + camera.w;
+    const float bottom = top + camera.h;
+
+    for (uint32_t i = 0; i < bullets.size(); i++) {
+      const float x = bullets.position_x[i] - bullets.velocity_x[i] * rewind;
+      const float y = bullets.position_y[i] - bullets.velocity_y[i] * rewind;
+
+      if (x + BULLET_SIZE < left || x > right || y + BULLET_SIZE < top || y > bottom)
+        continue;
+
+      packet.bullet_positions.push_back({x - left, y - top});
+    }
+  }
+
+  void Render(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+    if (packet.bullet_positions.empty() || !asset_manager->has_texture(bullet_texture)) return;
+
+    if (!use_geometry || !draw_geometry(renderer, asset_manager, packet))
+      draw_fallback(renderer, asset_manager, packet);
+  }
+
+private:
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  const static bool GEOMETRY_SUPPORTED = true;
+#else
+  const static bool GEOMETRY_SUPPORTED = false;
+#endif
+
+  bool use_geometry = GEOMETRY_SUPPORTED;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<SDL_Vertex> vertices;
+#endif
+  std::vector<int> indices;
+  const TextureHandle bullet_texture {"bullet-image"};
+
+  bool draw_geometry(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // The bullet image may be packed into an atlas, map the quad to its region
+    const SDL_Rect& region = asset_manager->get_texture_region(bullet_texture);
+    const SDL_Point page_size = asset_manager->get_page_size(packet.bullet_texture_page);
+    if (page_size.x <= 0 || page_size.y <= 0) return false;
+
+    const float u0 = static_cast<float>(region.x) / page_size.x;
+    const float v0 = static_cast<float>(region.y) / page_size.y;
+    const float u1 = static_cast<float>(region.x + region.w) / page_size.x;
+    const float v1 = static_cast<float>(region.y + region.h) / page_size.y;
+    const SDL_Color white = {255, 255, 255, 255};
+
+    vertices.clear();
+    for (const auto& position: packet.bullet_positions) {
+      vertices.push_back({{position.x, position.y}, white, {u0, v0}});
+      vertices.push_back({{position.x + BULLET_SIZE, position.y}, white, {u1, v0}});
+      vertices.push_back({{position.x + BULLET_SIZE, position.y + BULLET_SIZE}, white, {u1, v1}});
+      vertices.push_back({{position.x, position.y + BULLET_SIZE}, white, {u0, v1}});
+    }
+
+    const uint32_t num_of_quads = static_cast<uint32_t>(packet.bullet_positions.size());
+    for (uint32_t quad = static_cast<uint32_t>(indices.size() / 6); quad < num_of_quads; quad++) {
+      const int first = static_cast<int>(quad * 4);
+      indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    if (SDL_RenderGeometry(renderer, asset_manager->get_page_texture(packet.bullet_texture_page),
+                           vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(num_of_quads * 6)) != 0) {
+      Logger::Warn(std::string("SDL_RenderGeometry failed, bullets fall back to RenderCopy: ") + SDL_GetError());
+      use_geometry = false;
+      return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // One RenderCopy of the bullet image per bullet
+  void draw_fallback(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+    SDL_Texture* texture = asset_manager->get_page_texture(packet.bullet_texture_page);
+    const SDL_Rect& src_rect = asset_manager->get_texture_region(bullet_texture);
+
+    for (const auto& position: packet.bullet_positions) {
+      const SDL_Rect dst_rect = {
+        static_cast<int>(position.x),
+        static_cast<int>(position.y),
+        static_cast<int>(BULLET_SIZE),
+        static_cast<int>(BULLET_SIZE)
+      };
+      SDL_RenderCopy(renderer, texture, &src_rect, &dst_rect);
+    }
+  }
+};
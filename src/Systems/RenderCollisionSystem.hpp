@@ -6,20 +6,23 @@
 #include "../Components/BoxColliderComponent.hpp"
 #include "../Components/TransformComponent.hpp"
 #include "../Components/CollisionComponent.hpp"
+#include "../DebugDraw/DebugDraw.hpp"
+#include "./VisibilitySystem.hpp"
 
 class RenderCollisionSystem : public System {
   public:
     RenderCollisionSystem() {
       require_component<BoxColliderComponent>();
       require_component<TransformComponent>();
+      require_component<CollisionComponent>();
   }
    ~RenderCollisionSystem() = default;
 
-  void Update(SDL_Renderer* renderer, SDL_Rect& camera) {
-    for (auto& entity: get_system_entities()) {
+  void Extract(DebugDraw& debug_draw, const VisibilitySystem& visibility, SDL_Rect& camera) {
+    visibility.for_each_visible(*this, [&](const Entity& entity) {
       auto& collider = entity.get_component<BoxColliderComponent>();
       auto& transform = entity.get_component<TransformComponent>();
-      auto& is_colliding = entity.get_component<CollisionComponent>().is_colliding;
+      const auto& is_colliding = entity.get_component<CollisionComponent>().is_colliding;
 
       SDL_Rect rect {
         static_cast<int>(transform.position.x + collider.offset.x - camera.x),
@@ -28,14 +31,9 @@ class RenderCollisionSystem : public System {
         static_cast<int>(collider.height * transform.scale.y)
       };
 
-      if (is_colliding) // draw red if colliding
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-      else // else draw yellow
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-
-      SDL_RenderDrawRect(renderer, &rect);
-      entity.get_component<CollisionComponent>().is_colliding = false;
-    }
+      // Red if colliding, else yellow
+      debug_draw.draw_rect(rect, is_colliding ? SDL_Color{255, 0, 0, 255} : SDL_Color{255, 255, 0, 255});
+    });
   }
 
 };
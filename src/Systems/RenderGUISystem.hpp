@@ -13,6 +13,9 @@
 #include "../Components/ProjectileEmitterComponent.hpp"
 #include "../Components/MovingTextComponent.hpp"
 #include "../Components/GodModeComponent.hpp"
+#include "../Components/BulletPatternComponent.hpp"
+#include "./BulletSystem.hpp"
+#include "./VisibilitySystem.hpp"
 
 class RenderGUISystem : public System {
 public:
@@ -43,6 +46,9 @@ public:
     static float enemy_velocity_x = 90;
     static float enemy_velocity_y = 0;
     static std::string enemy_name = "";
+    static bool enemy_bullet_pattern = false;
+    static int32_t pattern_bullets = 32;
+    static int32_t pattern_repeat_speed = 250;
 
     if (ImGui::Begin("Spawn Enemies")) {
 
@@ -79,6 +85,11 @@ public:
       ImGui::SliderInt("Repeat speed (seconds)", &proj_repeat_speed, 1, 30);
       ImGui::SliderInt("Projectile duration (seconds)", &proj_duration, 1, 30);
 
+      ImGui::SeparatorText("Bullet pattern");
+      ImGui::Checkbox("Fire bullet pattern", &enemy_bullet_pattern);
+      ImGui::SliderInt("Bullets per ring", &pattern_bullets, 1, 512);
+      ImGui::SliderInt("Ring repeat speed (ms)", &pattern_repeat_speed, 16, 2000);
+
       // creates invis rect for space
       ImGui::Dummy(ImVec2(0, 15));
       
@@ -91,10 +102,22 @@ public:
         new_enemy.add_component<BoxColliderComponent>(box_collider_x, box_collider_y);
         new_enemy.add_component<CollisionComponent>();
         new_enemy.add_component<HealthComponent>(enemy_health);
-        new_enemy.add_component<ProjectileEmitterComponent>(glm::vec2(proj_vel_x, proj_vel_y), proj_repeat_speed * 1000, proj_duration * 1000, 10, false);
+        new_enemy.add_component<ProjectileEmitterComponent>(glm::vec2(proj_vel_x, proj_vel_y), proj_repeat_speed * 1000, proj_duration * 1000, 10, false, registry->get_clock().get_ticks());
         new_enemy.add_component<GodModeComponent>(enemy_godmode);
         new_enemy.add_component<MovingTextComponent>(7, -10, enemy_name.c_str(), "arial-font", SDL_Color {255, 0, 0});
+
+        if (enemy_bullet_pattern)
+          new_enemy.add_component<BulletPatternComponent>(pattern_bullets, 200, pattern_repeat_speed, proj_duration * 1000, 1, false, 7.5f, registry->get_clock().get_ticks());
       }
+
+      const auto projectile_pool = registry->get_entity_pool_stats("projectile");
+      ImGui::SeparatorText("Projectile pool");
+      ImGui::Text("Pooled: %u", projectile_pool.size);
+      ImGui::Text("Hit rate: %.1f%% (%u hits, %u misses)", projectile_pool.hit_rate() * 100.0f, projectile_pool.hits, projectile_pool.misses);
+      ImGui::Text("Bullets: %u", registry->get_system<BulletSystem>().get_num_of_bullets());
+
+      const auto& visibility = registry->get_system<VisibilitySystem>();
+      ImGui::Text("Visible: %u / %u entities", visibility.get_num_of_visible(), visibility.get_num_of_entities());
     }
     ImGui::End();
 
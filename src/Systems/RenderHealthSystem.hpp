@@ -3,9 +3,9 @@
 #include "../Components/HealthComponent.hpp"
 #include "../Components/TransformComponent.hpp"
 #include "../Components/SpriteComponent.hpp"
+#include "../DebugDraw/DebugDraw.hpp"
+#include "./VisibilitySystem.hpp"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_render.h>
-#include <SDL2/SDL_surface.h>
 
 class RenderHealthSystem : public System {
 public:
@@ -14,49 +14,42 @@ public:
     require_component<TransformComponent>();
   }
 
-  void Update(SDL_Renderer* renderer, const SDL_Rect& camera) {
-    for (auto& entity: get_system_entities()) {
+  void Extract(DebugDraw& debug_draw, const VisibilitySystem& visibility, const SDL_Rect& camera, float alpha) {
+    const uint16_t X_OFFSET = 15;
+    const uint16_t Y_OFFSET = 75;
+    const uint16_t HEIGHT = 5;
+    const uint16_t FULL_WIDTH = 60;
+
+    visibility.for_each_visible(*this, [&](const Entity& entity) {
       const auto& health = entity.get_component<HealthComponent>();
       const auto& transform = entity.get_component<TransformComponent>();
-      auto& sprite = entity.get_component<SpriteComponent>();
-
-      const uint16_t X_OFFSET = 15;
-      const uint16_t Y_OFFSET = 75;
-      const uint16_t HEIGHT = 5;
-      int16_t width = 60;
-
-      if (health.health_amount != 100) {
-        int16_t missing_health = 100 - health.health_amount;
-        while (missing_health > 0) {
-          width -= 6;
-          missing_health -= 10;
-        }
-      }
-
-      SDL_Rect rect {
-        static_cast<int>(transform.position.x - camera.x) + X_OFFSET,
-        static_cast<int>(transform.position.y - camera.y) + Y_OFFSET,
+      const glm::vec2 position = transform.interpolated_position(alpha);
+
+      // 6px off for every 10 health (or part of it) missing
+      const int16_t missing_health = 100 - health.health_amount;
+      const int16_t width = missing_health > 0 ? FULL_WIDTH - 6 * ((missing_health + 9) / 10) : FULL_WIDTH;
+
+      const SDL_Rect rect {
+        static_cast<int>(position.x - camera.x) + X_OFFSET,
+        static_cast<int>(position.y - camera.y) + Y_OFFSET,
         width,
         HEIGHT
       };
 
-      if (health.health_amount >= 71) {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-      }
-      else if (health.health_amount <= 70 && health.health_amount >= 31) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        if (entity.has_tag("player"))
-          sprite.asset_id = "player-hurt-image";
-      }
-      else {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        if (entity.has_tag("player"))
-          sprite.asset_id = "player-dying-image";
-      }
-
-      SDL_RenderFillRect(renderer, &rect);
-      SDL_RenderDrawRect(renderer, &rect);
-    }
+      SDL_Color color = COLOR_HEALTHY;
+      if (health.health_amount <= 30) color = COLOR_DYING;
+      else if (health.health_amount <= 70) color = COLOR_HURT;
+      debug_draw.fill_rect(rect, color);
+
+      if (health.health_amount <= 70 && entity.has_tag("player"))
+        entity.get_component<SpriteComponent>().texture = health.health_amount <= 30 ? player_dying_texture : player_hurt_texture;
+    });
   }
 
+private:
+  const SDL_Color COLOR_HEALTHY = {0, 255, 0, 255};
+  const SDL_Color COLOR_HURT = {255, 255, 0, 255};
+  const SDL_Color COLOR_DYING = {255, 0, 0, 255};
+  const TextureHandle player_hurt_texture {"player-hurt-image"};
+  const TextureHandle player_dying_texture {"player-dying-image"};
 };
@@ -0,0 +1,241 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../AssetManager/AssetManager.hpp"
+#include "../Components/StaticLayerComponent.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/SpriteComponent.hpp"
+#include "../FramePipeline/FramePacket.hpp"
+#include "../Logger/Logger.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Sprites that don't change (the playfield background, planets)
+// are composited once into a render target per layer, and each
+// frame a layer costs one copy of the part under the camera.
+//
+// Every frame the members' state (position, sprite...) is
+// extracted into the frame packet and compared against what the
+// layer was last drawn with, a layer is only composited again
+// when something in it changed or an entity joined/left it. The target only covers its members'
+// bounds, so a layer with one planet is a planet sized texture.
+//
+// A layer moves with camera * parallax: 1 is fixed to the world,
+// less than that scrolls slower and reads as further away. Keep
+// anything that collides at 1 or it drifts from its collider.
+//
+// Layer textures hold premultiplied alpha (that's what blending
+// into a transparent target gives), they're drawn with a blend
+// mode to match. A layer whose target can't be made, or would
+// be bigger than MAX_STATIC_LAYER_SIZE, is drawn sprite by
+// sprite instead.
+///////////////////////////////////////////////////////////////
+// Past this a layer's target costs more memory than redrawing it saves
+const int MAX_STATIC_LAYER_SIZE = 4096;
+
+class RenderLayerSystem : public System {
+public:
+  RenderLayerSystem() {
+    require_component<StaticLayerComponent>();
+    require_component<TransformComponent>();
+    require_component<SpriteComponent>();
+  }
+
+  ~RenderLayerSystem() {
+    invalidate();
+  }
+
+  void set_parallax(uint8_t layer, float parallax) {
+    if (layer < MAX_STATIC_LAYERS) layers[layer].parallax = parallax;
+  }
+
+  // Drops every cached layer, they're composited again on the next Render. Needed
+  // after the driver lost the render targets and before the renderer goes away
+  void invalidate() {
+    for (auto& layer: layers) {
+      if (layer.texture) SDL_DestroyTexture(layer.texture);
+      layer.texture = nullptr;
+      layer.members.clear();
+      layer.current_members.clear();
+      layer.is_cached = true;
+    }
+  }
+
+  // Simulation side, what every layer holds this frame
+  void Extract(FramePacket& packet) {
+    for (auto& entity: get_system_entities()) {
+      const auto& transform = entity.get_component<TransformComponent>();
+      const auto& sprite = entity.get_component<SpriteComponent>();
+      const uint8_t layer = std::min<uint8_t>(entity.get_component<StaticLayerComponent>().layer, MAX_STATIC_LAYERS - 1);
+
+      StaticLayerMember member;
+      member.entity_id = entity.get_entity_id();
+      member.x = transform.position.x;
+      member.y = transform.position.y;
+      member.width = sprite.width * transform.scale.x;
+      member.height = sprite.height * transform.scale.y;
+      member.rotation = static_cast<float>(transform.rotation);
+      member.src_rect = sprite.src_rect;
+      member.texture = sprite.texture.index;
+      member.z_index = sprite.z_index;
+      member.flip = sprite.flip;
+      packet.layer_members[layer].push_back(member);
+    }
+  }
+
+  // Render side, only composites the layers whose members changed. Called
+  // twice a frame, once for the layers under the tilemap and once for the
+  // ones over it
+  void Render(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet, bool above_map) {
+    const uint8_t first_layer = above_map ? STATIC_LAYER_DECORATION : 0;
+    const uint8_t end_layer = above_map ? MAX_STATIC_LAYERS : STATIC_LAYER_DECORATION;
+
+    for (uint8_t i = first_layer; i < end_layer; i++) {
+      Layer& layer = layers[i];
+      layer.current_members.assign(packet.layer_members[i].begin(), packet.layer_members[i].end());
+      sort_back_to_front(layer.current_members);
+
+      if (layer.current_members != layer.members) {
+        layer.members.swap(layer.current_members);
+        composite(renderer, asset_manager, layer);
+      }
+
+      if (layer.members.empty()) continue;
+      draw(renderer, asset_manager, layer, packet.camera);
+    }
+  }
+
+private:
+  struct Layer {
+    // What the texture was composited from, back to front
+    std::vector<StaticLayerMember> members;
+    // This frame's, kept to reuse its capacity
+    std::vector<StaticLayerMember> current_members;
+    SDL_Texture* texture = nullptr;
+    // World rect the texture covers
+    SDL_Rect bounds = {0, 0, 0, 0};
+    float parallax = 1.0f;
+    // False once making the target failed, the layer is drawn directly from then on
+    bool is_cached = true;
+  };
+
+  Layer layers[MAX_STATIC_LAYERS];
+
+  // Draw order within the layer, system order on ties. Has to run before
+  // comparing with the cached members, which are kept in this order, or
+  // any layer not already in z order would look changed every frame
+  static void sort_back_to_front(std::vector<StaticLayerMember>& members) {
+    std::stable_sort(members.begin(), members.end(), [](const StaticLayerMember& a, const StaticLayerMember& b) {
+      return a.z_index < b.z_index;
+    });
+  }
+
+  static SDL_Rect member_rect(const StaticLayerMember& member) {
+    // A rotated sprite can reach as far as its half diagonal from the centre
+    if (member.rotation != 0.0f) {
+      const float radius = 0.5f * std::sqrt(member.width * member.width + member.height * member.height);
+      const float center_x = member.x + member.width * 0.5f;
+      const float center_y = member.y + member.height * 0.5f;
+      return {
+        static_cast<int>(std::floor(center_x - radius)),
+        static_cast<int>(std::floor(center_y - radius)),
+        static_cast<int>(std::ceil(radius * 2.0f)) + 1,
+        static_cast<int>(std::ceil(radius * 2.0f)) + 1
+      };
+    }
+    return {static_cast<int>(member.x), static_cast<int>(member.y), static_cast<int>(member.width), static_cast<int>(member.height)};
+  }
+
+  static void draw_members(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const Layer& layer, int offset_x, int offset_y) {
+    for (const auto& member: layer.members) {
+      TextureHandle texture;
+      texture.index = member.texture;
+      if (!asset_manager->has_texture(texture)) continue;
+
+      const SDL_Rect src_rect = asset_manager->fold_src_rect(texture, member.src_rect);
+      const SDL_Rect dst_rect = {
+        static_cast<int>(member.x) - offset_x,
+        static_cast<int>(member.y) - offset_y,
+        static_cast<int>(member.width),
+        static_cast<int>(member.height)
+      };
+      SDL_RenderCopyEx(renderer, asset_manager->get_texture(texture), &src_rect, &dst_rect, member.rotation, NULL, member.flip);
+    }
+  }
+
+  void composite(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, Layer& layer) {
+    if (layer.members.empty()) {
+      if (layer.texture) SDL_DestroyTexture(layer.texture);
+      layer.texture = nullptr;
+      return;
+    }
+
+    SDL_Rect bounds = member_rect(layer.members[0]);
+    for (const auto& member: layer.members) {
+      const SDL_Rect rect = member_rect(member);
+      const int right = std::max(bounds.x + bounds.w, rect.x + rect.w);
+      const int bottom = std::max(bounds.y + bounds.h, rect.y + rect.h);
+      bounds.x = std::min(bounds.x, rect.x);
+      bounds.y = std::min(bounds.y, rect.y);
+      bounds.w = right - bounds.x;
+      bounds.h = bottom - bounds.y;
+    }
+    if (bounds.w <= 0 || bounds.h <= 0) return;
+
+    // Only remade when the bounds changed size
+    if (layer.texture && (bounds.w != layer.bounds.w || bounds.h != layer.bounds.h)) {
+      SDL_DestroyTexture(layer.texture);
+      layer.texture = nullptr;
+    }
+    layer.bounds = bounds;
+    if (!layer.is_cached || bounds.w > MAX_STATIC_LAYER_SIZE || bounds.h > MAX_STATIC_LAYER_SIZE) return;
+
+    if (!layer.texture) {
+      layer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, bounds.w, bounds.h);
+      if (!layer.texture) {
+        Logger::Warn(std::string("Failed creating a static layer target, drawing it uncached: ") + SDL_GetError());
+        layer.is_cached = false;
+        return;
+      }
+
+      const SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+      );
+      if (SDL_SetTextureBlendMode(layer.texture, premultiplied) != 0)
+        SDL_SetTextureBlendMode(layer.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, layer.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    draw_members(renderer, asset_manager, layer, bounds.x, bounds.y);
+    SDL_SetRenderTarget(renderer, previous_target);
+  }
+
+  void draw(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const Layer& layer, const SDL_Rect& camera) {
+    // Where the camera is looking in this layer
+    const SDL_Rect view = {
+      static_cast<int>(camera.x * layer.parallax),
+      static_cast<int>(camera.y * layer.parallax),
+      camera.w,
+      camera.h
+    };
+
+    if (!layer.texture) {
+      draw_members(renderer, asset_manager, layer, view.x, view.y);
+      return;
+    }
+
+    SDL_Rect visible;
+    if (!SDL_IntersectRect(&view, &layer.bounds, &visible)) return;
+
+    const SDL_Rect src_rect = {visible.x - layer.bounds.x, visible.y - layer.bounds.y, visible.w, visible.h};
+    const SDL_Rect dst_rect = {visible.x - view.x, visible.y - view.y, visible.w, visible.h};
+    SDL_RenderCopy(renderer, layer.texture, &src_rect, &dst_rect);
+  }
+};
@@ -2,11 +2,15 @@
 #include "../ECS/ECS.hpp"
 #include "../Components/TransformComponent.hpp"
 #include "../Components/SpriteComponent.hpp"
+#include "../Components/StaticLayerComponent.hpp"
 #include "../AssetManager/AssetManager.hpp"
+#include "../RenderQueue/RenderQueue.hpp"
+#include "../RenderQueue/SpriteBatcher.hpp"
+#include "../FramePipeline/FramePacket.hpp"
+#include "./VisibilitySystem.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_rect.h>
 #include <SDL2/SDL_render.h>
-#include <algorithm>
 #include <memory>
 
 class RenderSystem : public System {
@@ -19,48 +23,46 @@ public:
   RenderSystem(const RenderSystem&) = default;
   ~RenderSystem() = default;
 
-  // TODO: In future have layers, background layer, foreground, HUD, etc 
-  // if entity in layer HUD -> render first, background 2nd, etc.
-  // Pass in the layers to SpriteComponent instead of each individual z_index
- 
-  // NOTE: under what conditions would std::sort actually need to be called?
-  // how about only sorting when a new entity is added?
-  void Update(SDL_Renderer* renderer, std::unique_ptr<AssetManager>& asset_manager, SDL_Rect& camera) {
-    auto entities = get_system_entities();
+  // Fills the packet's render queue from the visible set and sorts it. The
+  // components are only read once per sprite, not once per comparison
+  void Extract(const std::unique_ptr<AssetManager>& asset_manager, const VisibilitySystem& visibility, const SDL_Rect& camera, float alpha, FramePacket& packet) {
+    RenderQueue& render_queue = packet.sprites;
 
-    std::sort(entities.begin(), entities.end(), [](const Entity& lhs, const Entity& rhs) {
-       return lhs.get_component<SpriteComponent>().z_index < rhs.get_component<SpriteComponent>().z_index;
-    });
+    visibility.for_each_visible(*this, [&](const Entity& entity) {
+      // Drawn from its cached layer by RenderLayerSystem
+      if (entity.has_component<StaticLayerComponent>()) return;
 
-    for (auto& entity: entities) {
       const auto& transform = entity.get_component<TransformComponent>();
       const auto& sprite = entity.get_component<SpriteComponent>();
+      const glm::vec2 position = transform.interpolated_position(alpha);
 
-      bool entity_outside_camera_view = (
-        transform.position.x + (transform.scale.x * sprite.width) < camera.x ||
-        transform.position.x > camera.x + camera.w ||
-        transform.position.y + (transform.scale.y * sprite.height) < camera.y ||
-        transform.position.y > camera.y + camera.h
-      );
-
-      if (entity_outside_camera_view && !sprite.is_fixed) continue;
+      if (!asset_manager->has_texture(sprite.texture)) return;
 
-      // Set source rectangle of OG sprite texture, needed for RenderCopy
-      SDL_Rect source_rect = sprite.src_rect;
-
-      SDL_Rect destination_rect = {
-        static_cast<int>(transform.position.x - (sprite.is_fixed ? 0 : camera.x)),
-        static_cast<int>(transform.position.y - (sprite.is_fixed ? 0 : camera.y)),
+      RenderCommand command;
+      // Source rectangle of the OG sprite texture, moved to wherever it
+      // was packed in the atlas
+      command.src_rect = asset_manager->fold_src_rect(sprite.texture, sprite.src_rect);
+      command.dst_rect = {
+        static_cast<int>(position.x - (sprite.is_fixed ? 0 : camera.x)),
+        static_cast<int>(position.y - (sprite.is_fixed ? 0 : camera.y)),
         static_cast<int>(sprite.width * transform.scale.x),
         static_cast<int>(sprite.height * transform.scale.y)
       };
+      command.rotation = transform.rotation;
+      command.flip = sprite.flip;
+      command.texture_page = asset_manager->get_texture_page(sprite.texture);
+
+      render_queue.push(sprite.is_fixed ? RENDER_LAYER_FIXED : RENDER_LAYER_WORLD, sprite.z_index, command);
+    });
+
+    render_queue.sort();
+  }
 
-      SDL_RenderCopyEx(renderer, asset_manager->get_texture(sprite.asset_id), 
-                     &source_rect, &destination_rect, transform.rotation,
-                     NULL, sprite.flip);
-    }
+  // One RenderGeometry call per run of same texture sprites
+  void Render(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+    sprite_batcher.draw(renderer, asset_manager, packet.sprites);
   }
 
 private:
-  
+  SpriteBatcher sprite_batcher;
 };
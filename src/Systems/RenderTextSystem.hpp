@@ -2,8 +2,12 @@
 #include "../ECS/ECS.hpp"
 #include "../AssetManager/AssetManager.hpp"
 #include "../Components/TextComponent.hpp"
+#include "../FramePipeline/FramePacket.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_render.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 class RenderTextSystem : public System {
 public:
@@ -11,32 +15,54 @@ public:
     require_component<TextComponent>();
   }
 
-  void Update(std::unique_ptr<AssetManager>& asset_manager, SDL_Renderer* renderer, const SDL_Rect& camera, const uint16_t& current_fps) {
+  void Extract(const SDL_Rect& camera, uint16_t current_fps, FramePacket& packet) {
     for (auto& entity: get_system_entities()) {
       auto& text = entity.get_component<TextComponent>();
 
       if (entity.has_tag("fps"))
         text.text = "FPS: " + std::to_string(current_fps);
 
-      SDL_Surface* surface = TTF_RenderText_Blended(asset_manager->get_font(text.asset_id), text.text.c_str(), text.color);
-      SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-      SDL_FreeSurface(surface);
+      packet.push_text(
+        packet.texts,
+        text.text,
+        static_cast<int>(text.position.x - (text.is_fixed ? 0 : camera.x)),
+        static_cast<int>(text.position.y - (text.is_fixed ? 0 : camera.y)),
+        text.color,
+        text.font,
+        text.is_dynamic
+      );
+    }
+  }
 
-      int32_t text_width = 0;
-      int32_t text_height = 0;
+  void Render(SDL_Renderer* renderer, std::unique_ptr<AssetManager>& asset_manager, const FramePacket& packet) {
+    for (const auto& command: packet.texts) {
+      packet.get_text(command, text);
 
-      SDL_QueryTexture(texture, NULL, NULL, &text_width, &text_height);
+      if (command.is_dynamic) {
+        GlyphAtlas* glyph_atlas = asset_manager->get_glyph_atlas(renderer, command.font);
+        if (!glyph_atlas) continue;
 
-      SDL_Rect dst_rect {
-        static_cast<int>(text.position.x - (text.is_fixed ? 0 : camera.x)),
-        static_cast<int>(text.position.y - (text.is_fixed ? 0 : camera.y)),
-        text_width,
-        text_height
-      };
+        glyph_atlas->queue_text(text, command.x, command.y, command.color);
+        if (std::find(queued_atlases.begin(), queued_atlases.end(), glyph_atlas) == queued_atlases.end())
+          queued_atlases.push_back(glyph_atlas);
+        continue;
+      }
 
-      SDL_RenderCopy(renderer, texture, NULL, &dst_rect);
-      SDL_DestroyTexture(texture);
+      const TextTexture text_texture = asset_manager->get_text(renderer, command.font, text, command.color);
+      if (!text_texture.texture) continue;
+
+      SDL_Rect dst_rect {command.x, command.y, text_texture.width, text_texture.height};
+      SDL_RenderCopy(renderer, text_texture.texture, NULL, &dst_rect);
     }
+
+    // One draw per font for all the dynamic text
+    for (auto glyph_atlas: queued_atlases)
+      glyph_atlas->flush(renderer);
+    queued_atlases.clear();
   }
 
+private:
+  std::vector<GlyphAtlas*> queued_atlases;
+  // Scratch copy of the command being drawn
+  std::string text;
 };
@@ -0,0 +1,155 @@
+#pragma once
+#include "../ECS/ECS.hpp"
+#include "../Components/TransformComponent.hpp"
+#include "../Components/SpriteComponent.hpp"
+#include "../Components/BoxColliderComponent.hpp"
+#include "../Components/RigidBodyComponent.hpp"
+#include "../Visibility/VisibilityGrid.hpp"
+#include "../Game/Game.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <vector>
+
+const float VISIBILITY_CELL_SIZE = 256.0f;
+// Health bars and labels are drawn around the sprite, not on it
+const float VISIBILITY_MARGIN = 96.0f;
+
+///////////////////////////////////////////////////////////////
+// Works out once per frame which entities can be seen, so the
+// render systems walk the visible set instead of every entity
+// they have and each doing its own camera test.
+//
+// An entity's render bounds are its sprite and collider boxes
+// grown by VISIBILITY_MARGIN. Entities without a RigidBody
+// never move, their bounds go into a VisibilityGrid that is
+// only rebuilt when one of them joins or leaves, and the camera
+// rect is looked up in it. Moving entities would need the grid
+// rebuilt every frame for a single lookup, they're tested
+// against the camera directly. Screen space (is_fixed) sprites
+// are always visible.
+//
+// The visible set is sorted by entity id, so it comes out in
+// the same order every run. for_each_visible() hands a system
+// the visible entities that match its own signature.
+///////////////////////////////////////////////////////////////
+class VisibilitySystem : public System {
+public:
+  VisibilitySystem() {
+    require_component<TransformComponent>();
+  }
+
+  void add_entity_to_system(Entity entity) override {
+    System::add_entity_to_system(entity);
+    if (!entity.has_component<RigidBodyComponent>()) is_grid_stale = true;
+  }
+
+  void remove_entity_from_system(Entity entity) override {
+    System::remove_entity_from_system(entity);
+    if (!entity.has_component<RigidBodyComponent>()) is_grid_stale = true;
+  }
+
+  void Update(const SDL_Rect& camera, float alpha) {
+    const auto& entities = get_entities();
+
+    if (is_grid_stale || grid_width != Game::map_width || grid_height != Game::map_height)
+      build_static_grid(entities);
+
+    visible_entities.assign(fixed_entities.begin(), fixed_entities.end());
+    grid.query(camera.x, camera.y, camera.x + camera.w, camera.y + camera.h, [this](uint32_t box) {
+      visible_entities.push_back(static_entities[box]);
+    });
+
+    for (const auto& entity: entities) {
+      if (!entity.has_component<RigidBodyComponent>()) continue;
+
+      const Bounds bounds = get_bounds(entity, entity.get_component<TransformComponent>().interpolated_position(alpha));
+      if (bounds.is_fixed || (camera.x < bounds.max_x && camera.x + camera.w > bounds.min_x &&
+                              camera.y < bounds.max_y && camera.y + camera.h > bounds.min_y))
+        visible_entities.push_back(entity);
+    }
+
+    std::sort(visible_entities.begin(), visible_entities.end());
+    num_of_entities = static_cast<uint32_t>(entities.size());
+  }
+
+  // Calls func(entity) for each visible entity the system would have in its own list
+  template <typename T_func>
+  void for_each_visible(const System& system, T_func&& func) const {
+    for (const auto& entity: visible_entities)
+      if (system.accepts(entity)) func(entity);
+  }
+
+  const std::vector<Entity>& get_visible_entities() const { return visible_entities; }
+  uint32_t get_num_of_visible() const { return static_cast<uint32_t>(visible_entities.size()); }
+  uint32_t get_num_of_entities() const { return num_of_entities; }
+
+private:
+  struct Bounds {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    bool is_fixed;
+  };
+
+  VisibilityGrid grid;
+  bool is_grid_stale = true;
+  uint16_t grid_width = 0;
+  uint16_t grid_height = 0;
+  // Box n of the grid is static_entities[n]
+  std::vector<Entity> static_entities;
+  std::vector<Entity> fixed_entities;
+  std::vector<Entity> visible_entities;
+  uint32_t num_of_entities = 0;
+
+  static Bounds get_bounds(const Entity& entity, const glm::vec2& position) {
+    const auto& transform = entity.get_component<TransformComponent>();
+    float width = 0.0f;
+    float height = 0.0f;
+    bool is_fixed = false;
+
+    if (entity.has_component<SpriteComponent>()) {
+      const auto& sprite = entity.get_component<SpriteComponent>();
+      width = sprite.width * transform.scale.x;
+      height = sprite.height * transform.scale.y;
+      is_fixed = sprite.is_fixed;
+    }
+    if (entity.has_component<BoxColliderComponent>()) {
+      const auto& collider = entity.get_component<BoxColliderComponent>();
+      width = std::max(width, collider.offset.x + collider.width * transform.scale.x);
+      height = std::max(height, collider.offset.y + collider.height * transform.scale.y);
+    }
+
+    return {
+      position.x - VISIBILITY_MARGIN,
+      position.y - VISIBILITY_MARGIN,
+      position.x + width + VISIBILITY_MARGIN,
+      position.y + height + VISIBILITY_MARGIN,
+      is_fixed
+    };
+  }
+
+  void build_static_grid(const std::vector<Entity>& entities) {
+    grid_width = Game::map_width;
+    grid_height = Game::map_height;
+    grid.reset(grid_width, grid_height, VISIBILITY_CELL_SIZE);
+    static_entities.clear();
+    fixed_entities.clear();
+
+    for (const auto& entity: entities) {
+      if (entity.has_component<RigidBodyComponent>()) continue;
+
+      const Bounds bounds = get_bounds(entity, entity.get_component<TransformComponent>().position);
+      if (bounds.is_fixed) {
+        fixed_entities.push_back(entity);
+        continue;
+      }
+
+      static_entities.push_back(entity);
+      grid.add(bounds.min_x, bounds.min_y, bounds.max_x, bounds.max_y);
+    }
+
+    grid.build();
+    is_grid_stale = false;
+  }
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../Logger/Logger.hpp"
+
+///////////////////////////////////////////////////////////////
+// Fixed set of worker threads for splitting a frame's work
+// into tasks. parallel_for hands out task indices until they
+// are all done and blocks until then, the calling thread
+// takes tasks too so nothing sits idle.
+//
+// Tasks must only write to memory owned by their index, which
+// keeps the merged results independent of scheduling.
+///////////////////////////////////////////////////////////////
+class ThreadPool {
+public:
+  ThreadPool(uint32_t num_of_threads = std::thread::hardware_concurrency()) {
+    // The caller helps out, so one less worker than threads
+    uint32_t num_of_workers = (num_of_threads > 1) ? num_of_threads - 1 : 0;
+
+    for (uint32_t i = 0; i < num_of_workers; i++)
+      workers.emplace_back(&ThreadPool::worker_loop, this);
+
+    Logger::Log("ThreadPool Constructor called with [" + std::to_string(num_of_workers) + "] workers!");
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      is_stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (auto& worker: workers)
+      worker.join();
+
+    Logger::Log("ThreadPool Destructor called!");
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  uint32_t get_num_of_threads() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+  void parallel_for(uint32_t num_of_tasks, const std::function<void(uint32_t)>& task) {
+    if (num_of_tasks == 0) return;
+
+    if (workers.empty() || num_of_tasks == 1) {
+      for (uint32_t i = 0; i < num_of_tasks; i++)
+        task(i);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      current_task = &task;
+      total_tasks = num_of_tasks;
+      next_task.store(0);
+      tasks_remaining.store(num_of_tasks);
+      job_id++;
+    }
+    work_ready.notify_all();
+
+    run_tasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    work_done.wait(lock, [this]() { return tasks_remaining.load() == 0 && active_workers == 0; });
+    current_task = nullptr;
+  }
+
+private:
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable work_ready;
+  std::condition_variable work_done;
+
+  const std::function<void(uint32_t)>* current_task = nullptr;
+  uint32_t total_tasks = 0;
+  uint64_t job_id = 0;
+  uint32_t active_workers = 0;
+  bool is_stopping = false;
+  std::atomic<uint32_t> next_task {0};
+  std::atomic<uint32_t> tasks_remaining {0};
+
+  void run_tasks() {
+    for (uint32_t i = next_task.fetch_add(1); i < total_tasks; i = next_task.fetch_add(1)) {
+      (*current_task)(i);
+      tasks_remaining.fetch_sub(1);
+    }
+  }
+
+  void worker_loop() {
+    uint64_t last_job_id = 0;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        work_ready.wait(lock, [&]() { return is_stopping || (job_id != last_job_id && current_task); });
+        if (is_stopping) return;
+
+        last_job_id = job_id;
+        active_workers++;
+      }
+
+      run_tasks();
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        active_workers--;
+      }
+      work_done.notify_all();
+    }
+  }
+};
@@ -0,0 +1,154 @@
+#include "./Tilemap.hpp"
+#include "../Logger/Logger.hpp"
+#include <SDL2/SDL_render.h>
+#include <algorithm>
+
+Tilemap::Tilemap()
+  : tile_size{0}, tile_scale{1}, chunk_columns{0}, chunk_rows{0} {
+  Logger::Log("Tilemap Constructor called!");
+}
+
+Tilemap::~Tilemap() {
+  release_chunks();
+  Logger::Log("Tilemap Destructor called!");
+}
+
+static bool ends_with(const std::string& text, const std::string& suffix) {
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool Tilemap::load(const std::string& map_path, TextureHandle tileset, uint16_t tile_size, uint16_t tile_scale) {
+  clear();
+
+  if (ends_with(map_path, ".map")) {
+    // Old CSV maps go through the binary layout too, just without collision
+    TilemapGrid grid;
+    if (!parse_tilemap_csv(map_path, grid) || !file.open_image(encode_tilemap(grid, TILEMAP_DEFAULT_CHUNK_TILES, {})))
+      return false;
+  }
+  else if (!file.open(map_path)) {
+    return false;
+  }
+
+  this->tile_size = tile_size;
+  this->tile_scale = tile_scale;
+  this->tileset = tileset;
+  invalidate();
+
+  Logger::Log("Tilemap " + map_path + " loaded, " + std::to_string(get_columns()) + "x" + std::to_string(get_rows()) + " tiles");
+  return true;
+}
+
+SDL_Rect Tilemap::get_chunk_rect(int32_t chunk_column, int32_t chunk_row) const {
+  const int32_t x = chunk_column * TILEMAP_CHUNK_SIZE;
+  const int32_t y = chunk_row * TILEMAP_CHUNK_SIZE;
+  return {x, y, std::min(TILEMAP_CHUNK_SIZE, get_width() - x), std::min(TILEMAP_CHUNK_SIZE, get_height() - y)};
+}
+
+void Tilemap::invalidate() {
+  release_chunks();
+  if (!is_loaded()) return;
+
+  chunk_columns = (get_width() + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+  chunk_rows = (get_height() + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+  chunks.assign(chunk_columns * chunk_rows, nullptr);
+  chunk_tried.assign(chunk_columns * chunk_rows, false);
+}
+
+void Tilemap::bake_chunk(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, int32_t chunk_column, int32_t chunk_row) {
+  const uint32_t chunk_index = chunk_row * chunk_columns + chunk_column;
+  chunk_tried[chunk_index] = true;
+
+  if (!asset_manager->has_texture(tileset)) {
+    Logger::Err("Tilemap tileset [" + tileset.get_asset_id() + "] isn't loaded");
+    return;
+  }
+
+  SDL_Texture* tileset_texture = asset_manager->get_texture(tileset);
+  const SDL_Rect& tileset_region = asset_manager->get_texture_region(tileset);
+  const uint32_t tileset_columns = tileset_region.w / tile_size;
+  const uint32_t num_of_tileset_tiles = tileset_columns * (tileset_region.h / tile_size);
+  const int32_t tile_world_size = get_tile_world_size();
+  const SDL_Rect chunk_rect = get_chunk_rect(chunk_column, chunk_row);
+
+  SDL_Texture* chunk = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, chunk_rect.w, chunk_rect.h);
+  if (!chunk) {
+    Logger::Err(std::string("Failed creating tilemap chunk: ") + SDL_GetError());
+    return;
+  }
+  SDL_SetTextureBlendMode(chunk, SDL_BLENDMODE_BLEND);
+
+  SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, chunk);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+
+  // Tiles overlapping the chunk, the ones on its edge get clipped
+  const int32_t first_column = chunk_rect.x / tile_world_size;
+  const int32_t last_column = std::min<int32_t>(get_columns() - 1, (chunk_rect.x + chunk_rect.w - 1) / tile_world_size);
+  const int32_t first_row = chunk_rect.y / tile_world_size;
+  const int32_t last_row = std::min<int32_t>(get_rows() - 1, (chunk_rect.y + chunk_rect.h - 1) / tile_world_size);
+
+  for (int32_t row = first_row; row <= last_row; row++) {
+    for (int32_t column = first_column; column <= last_column; column++) {
+      const uint16_t tile = get_tile(column, row);
+      if (tile == TILEMAP_EMPTY_TILE || tile >= num_of_tileset_tiles) continue;
+
+      const SDL_Rect src_rect = asset_manager->fold_src_rect(tileset, {
+        static_cast<int>((tile % tileset_columns) * tile_size),
+        static_cast<int>((tile / tileset_columns) * tile_size),
+        tile_size,
+        tile_size
+      });
+      const SDL_Rect dst_rect = {
+        column * tile_world_size - chunk_rect.x,
+        row * tile_world_size - chunk_rect.y,
+        tile_world_size,
+        tile_world_size
+      };
+      SDL_RenderCopy(renderer, tileset_texture, &src_rect, &dst_rect);
+    }
+  }
+
+  SDL_SetRenderTarget(renderer, previous_target);
+  chunks[chunk_index] = chunk;
+}
+
+void Tilemap::render(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const SDL_Rect& camera) {
+  if (chunks.empty()) return;
+
+  const int32_t first_column = std::max(camera.x, 0) / TILEMAP_CHUNK_SIZE;
+  const int32_t last_column = std::min(chunk_columns - 1, (camera.x + camera.w - 1) / TILEMAP_CHUNK_SIZE);
+  const int32_t first_row = std::max(camera.y, 0) / TILEMAP_CHUNK_SIZE;
+  const int32_t last_row = std::min(chunk_rows - 1, (camera.y + camera.h - 1) / TILEMAP_CHUNK_SIZE);
+
+  for (int32_t chunk_row = first_row; chunk_row <= last_row; chunk_row++) {
+    for (int32_t chunk_column = first_column; chunk_column <= last_column; chunk_column++) {
+      const uint32_t chunk_index = chunk_row * chunk_columns + chunk_column;
+      if (!chunk_tried[chunk_index])
+        bake_chunk(renderer, asset_manager, chunk_column, chunk_row);
+
+      SDL_Texture* chunk = chunks[chunk_index];
+      if (!chunk) continue;
+
+      SDL_Rect dst_rect = get_chunk_rect(chunk_column, chunk_row);
+      dst_rect.x -= camera.x;
+      dst_rect.y -= camera.y;
+      SDL_RenderCopy(renderer, chunk, NULL, &dst_rect);
+    }
+  }
+}
+
+void Tilemap::release_chunks() {
+  for (auto chunk: chunks)
+    if (chunk) SDL_DestroyTexture(chunk);
+  chunks.clear();
+  chunk_tried.clear();
+  chunk_columns = 0;
+  chunk_rows = 0;
+}
+
+void Tilemap::clear() {
+  release_chunks();
+  file.close();
+}
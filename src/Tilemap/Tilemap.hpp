@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "../AssetManager/AssetManager.hpp"
+#include "./TilemapFile.hpp"
+
+// Side of a baked chunk in world pixels, chunks on the right/bottom edge may be smaller
+const int32_t TILEMAP_CHUNK_SIZE = 512;
+
+///////////////////////////////////////////////////////////////
+// A grid of tiles, drawn as prebaked chunks instead of one
+// entity (and one RenderCopy) per tile.
+//
+// Tiles are tileset indices, counted row-major through the
+// tileset image, so with the 10 tile wide jungle set "21" is
+// row 2, column 1. Maps come in two formats:
+//  - .map, a CSV with one row of tiles per line (a negative
+//    entry leaves the cell empty), parsed and converted to the
+//    binary layout in memory on load
+//  - anything else, the binary format from TilemapFile.hpp,
+//    mmapped and read in place (make tilemaps converts .map)
+//
+// Chunks are TILEMAP_CHUNK_SIZE square render targets baked
+// the first time they come into view, after that render() only
+// copies the chunks the camera overlaps: a handful of copies a
+// frame however big the map is, and a large world only ever
+// touches the parts of the file that were on screen. Render
+// targets can be lost (SDL_RENDER_TARGETS_RESET), invalidate()
+// drops them all so they're baked again from the tiles.
+///////////////////////////////////////////////////////////////
+class Tilemap {
+public:
+  Tilemap();
+  ~Tilemap();
+
+  // The tileset must be a loaded texture by the time anything is drawn
+  bool load(const std::string& map_path, TextureHandle tileset, uint16_t tile_size, uint16_t tile_scale);
+  void invalidate();
+  void render(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, const SDL_Rect& camera);
+  void clear();
+
+  bool is_loaded() const { return file.is_open(); }
+  const TilemapFile& get_file() const { return file; }
+  uint16_t get_columns() const { return file.get_header().columns; }
+  uint16_t get_rows() const { return file.get_header().rows; }
+  uint16_t get_tile(uint16_t column, uint16_t row) const { return file.get_tile(column, row); }
+  // Size of one tile and of the whole map in world pixels
+  int32_t get_tile_world_size() const { return tile_size * tile_scale; }
+  int32_t get_width() const { return get_columns() * get_tile_world_size(); }
+  int32_t get_height() const { return get_rows() * get_tile_world_size(); }
+
+private:
+  TilemapFile file;
+  uint16_t tile_size;
+  uint16_t tile_scale;
+  TextureHandle tileset;
+
+  // Row-major, chunk_columns * chunk_rows, nullptr until baked
+  std::vector<SDL_Texture*> chunks;
+  // Baking is tried once per chunk, a failed one stays blank
+  std::vector<bool> chunk_tried;
+  int32_t chunk_columns;
+  int32_t chunk_rows;
+
+  SDL_Rect get_chunk_rect(int32_t chunk_column, int32_t chunk_row) const;
+  void bake_chunk(SDL_Renderer* renderer, const std::unique_ptr<AssetManager>& asset_manager, int32_t chunk_column, int32_t chunk_row);
+  void release_chunks();
+};
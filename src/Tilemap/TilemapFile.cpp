@@ -0,0 +1,249 @@
+#include "./TilemapFile.hpp"
+#include "../Logger/Logger.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool parse_tilemap_csv(const std::string& map_path, TilemapGrid& grid) {
+  std::ifstream map_file(map_path);
+  if (!map_file) {
+    Logger::Err("Failed opening tilemap " + map_path);
+    return false;
+  }
+
+  std::vector<uint16_t> tiles;
+  uint32_t columns = 0;
+  uint32_t rows = 0;
+  std::string line;
+
+  while (std::getline(map_file, line)) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+    std::stringstream row(line);
+    std::string cell;
+    uint32_t row_columns = 0;
+
+    while (std::getline(row, cell, ',')) {
+      char* end = nullptr;
+      const long tile = std::strtol(cell.c_str(), &end, 10);
+      if (end == cell.c_str()) {
+        Logger::Err("Bad tile [" + cell + "] on row " + std::to_string(rows) + " of " + map_path);
+        return false;
+      }
+
+      tiles.push_back((tile < 0 || tile >= TILEMAP_EMPTY_TILE) ? TILEMAP_EMPTY_TILE : static_cast<uint16_t>(tile));
+      row_columns++;
+    }
+
+    if (rows == 0) columns = row_columns;
+    if (row_columns != columns) {
+      Logger::Err("Row " + std::to_string(rows) + " of " + map_path + " has " + std::to_string(row_columns) + " tiles, expected " + std::to_string(columns));
+      return false;
+    }
+    rows++;
+  }
+
+  if (tiles.empty() || columns > UINT16_MAX || rows > UINT16_MAX) {
+    Logger::Err("Tilemap " + map_path + " is empty or too big");
+    return false;
+  }
+
+  grid.columns = static_cast<uint16_t>(columns);
+  grid.rows = static_cast<uint16_t>(rows);
+  grid.tiles = std::move(tiles);
+  return true;
+}
+
+// Appends a block 8 byte aligned, returns where it starts
+static uint32_t append_block(std::vector<uint8_t>& bytes, const void* block, size_t block_size) {
+  bytes.resize((bytes.size() + 7) & ~static_cast<size_t>(7), 0);
+  const uint32_t offset = static_cast<uint32_t>(bytes.size());
+  const uint8_t* block_bytes = static_cast<const uint8_t*>(block);
+  bytes.insert(bytes.end(), block_bytes, block_bytes + block_size);
+  return offset;
+}
+
+std::vector<uint8_t> encode_tilemap(const TilemapGrid& grid, uint16_t chunk_tiles, const std::vector<bool>& solid_tiles) {
+  TilemapFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = TILEMAP_FILE_MAGIC;
+  header.version = TILEMAP_FILE_VERSION;
+  header.flags = solid_tiles.empty() ? 0 : TILEMAP_FILE_HAS_COLLISION;
+  header.columns = grid.columns;
+  header.rows = grid.rows;
+  header.chunk_tiles = chunk_tiles;
+  header.chunk_columns = static_cast<uint16_t>((grid.columns + chunk_tiles - 1) / chunk_tiles);
+  header.chunk_rows = static_cast<uint16_t>((grid.rows + chunk_tiles - 1) / chunk_tiles);
+  header.directory_offset = sizeof(TilemapFileHeader);
+
+  std::vector<TilemapChunkEntry> directory(header.chunk_columns * header.chunk_rows, {0, 0});
+  std::vector<uint8_t> bytes(sizeof(TilemapFileHeader) + directory.size() * sizeof(TilemapChunkEntry), 0);
+
+  std::vector<uint16_t> chunk(chunk_tiles * chunk_tiles);
+  std::vector<uint64_t> collision(chunk_tiles);
+
+  for (uint16_t chunk_row = 0; chunk_row < header.chunk_rows; chunk_row++) {
+    for (uint16_t chunk_column = 0; chunk_column < header.chunk_columns; chunk_column++) {
+      bool is_empty = true;
+      bool has_solid = false;
+      std::fill(collision.begin(), collision.end(), 0);
+
+      for (uint16_t y = 0; y < chunk_tiles; y++) {
+        for (uint16_t x = 0; x < chunk_tiles; x++) {
+          const uint32_t column = chunk_column * chunk_tiles + x;
+          const uint32_t row = chunk_row * chunk_tiles + y;
+          const uint16_t tile = (column < grid.columns && row < grid.rows) ? grid.tiles[row * grid.columns + column] : TILEMAP_EMPTY_TILE;
+
+          chunk[y * chunk_tiles + x] = tile;
+          if (tile == TILEMAP_EMPTY_TILE) continue;
+          is_empty = false;
+
+          if (tile < solid_tiles.size() && solid_tiles[tile]) {
+            collision[y] |= uint64_t(1) << x;
+            has_solid = true;
+          }
+        }
+      }
+
+      if (is_empty) continue;
+
+      TilemapChunkEntry& entry = directory[chunk_row * header.chunk_columns + chunk_column];
+      entry.tiles_offset = append_block(bytes, chunk.data(), chunk.size() * sizeof(uint16_t));
+      if (has_solid)
+        entry.collision_offset = append_block(bytes, collision.data(), collision.size() * sizeof(uint64_t));
+    }
+  }
+
+  header.file_size = bytes.size();
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  std::memcpy(bytes.data() + header.directory_offset, directory.data(), directory.size() * sizeof(TilemapChunkEntry));
+  return bytes;
+}
+
+TilemapFile::TilemapFile() : data{nullptr}, size{0}, is_mapped{false} {}
+
+TilemapFile::~TilemapFile() {
+  close();
+}
+
+bool TilemapFile::open(const std::string& file_path) {
+  close();
+
+#if defined(__unix__) || defined(__APPLE__)
+  const int file = ::open(file_path.c_str(), O_RDONLY);
+  if (file < 0) {
+    Logger::Err("Failed opening tilemap " + file_path);
+    return false;
+  }
+
+  struct stat file_stat;
+  void* mapping = MAP_FAILED;
+  if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0)
+    mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping keeps the file alive on its own
+  ::close(file);
+
+  if (mapping == MAP_FAILED) {
+    Logger::Err("Failed mapping tilemap " + file_path);
+    return false;
+  }
+
+  data = static_cast<const uint8_t*>(mapping);
+  size = file_stat.st_size;
+  is_mapped = true;
+#else
+  // No mmap, read it in whole, still no parsing
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    Logger::Err("Failed opening tilemap " + file_path);
+    return false;
+  }
+  image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  data = image.data();
+  size = image.size();
+#endif
+
+  if (!validate(file_path)) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool TilemapFile::open_image(std::vector<uint8_t>&& image) {
+  close();
+
+  this->image = std::move(image);
+  data = this->image.data();
+  size = this->image.size();
+
+  if (!validate("in-memory image")) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void TilemapFile::close() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (is_mapped) munmap(const_cast<uint8_t*>(data), size);
+#endif
+  image.clear();
+  image.shrink_to_fit();
+  data = nullptr;
+  size = 0;
+  is_mapped = false;
+}
+
+// Everything the accessors rely on is checked here, once
+bool TilemapFile::validate(const std::string& name) const {
+  if (!data || size < sizeof(TilemapFileHeader)) {
+    Logger::Err("Tilemap " + name + " is too small");
+    return false;
+  }
+
+  const TilemapFileHeader& header = get_header();
+  if (header.magic != TILEMAP_FILE_MAGIC || header.version != TILEMAP_FILE_VERSION) {
+    Logger::Err("Tilemap " + name + " isn't a version " + std::to_string(TILEMAP_FILE_VERSION) + " tilemap");
+    return false;
+  }
+
+  const uint16_t chunk_tiles = header.chunk_tiles;
+  if (chunk_tiles == 0 || chunk_tiles > TILEMAP_MAX_CHUNK_TILES || header.columns == 0 || header.rows == 0 ||
+      header.chunk_columns != (header.columns + chunk_tiles - 1) / chunk_tiles ||
+      header.chunk_rows != (header.rows + chunk_tiles - 1) / chunk_tiles ||
+      header.file_size != size) {
+    Logger::Err("Tilemap " + name + " has a broken header");
+    return false;
+  }
+
+  const size_t num_of_chunks = header.chunk_columns * header.chunk_rows;
+  if (header.directory_offset % 8 != 0 || header.directory_offset + num_of_chunks * sizeof(TilemapChunkEntry) > size) {
+    Logger::Err("Tilemap " + name + " has a broken chunk directory");
+    return false;
+  }
+
+  const size_t tiles_bytes = chunk_tiles * chunk_tiles * sizeof(uint16_t);
+  const size_t collision_bytes = chunk_tiles * sizeof(uint64_t);
+  const TilemapChunkEntry* directory = reinterpret_cast<const TilemapChunkEntry*>(data + header.directory_offset);
+
+  for (size_t i = 0; i < num_of_chunks; i++) {
+    const TilemapChunkEntry& entry = directory[i];
+    const bool tiles_ok = entry.tiles_offset == 0 || (entry.tiles_offset % 8 == 0 && entry.tiles_offset + tiles_bytes <= size);
+    const bool collision_ok = entry.collision_offset == 0 || (entry.collision_offset % 8 == 0 && entry.collision_offset + collision_bytes <= size);
+    if (!tiles_ok || !collision_ok) {
+      Logger::Err("Tilemap " + name + " chunk " + std::to_string(i) + " points outside the file");
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Binary tilemap, laid out so it can be mapped straight into
+// memory and used where it lies, no parsing or copying:
+//
+//   TilemapFileHeader
+//   TilemapChunkEntry[chunk_columns * chunk_rows]  (row-major)
+//   chunk blocks, each starting 8 byte aligned:
+//     uint16_t tiles[chunk_tiles * chunk_tiles]     row-major
+//     uint64_t collision[chunk_tiles]               optional
+//
+// The map is cut into square chunks of chunk_tiles tiles, cells
+// past the map edge are EMPTY. A chunk with nothing in it isn't
+// stored at all (tiles_offset 0). Collision is one word per
+// chunk row, bit n set = column n is solid, which is why a chunk
+// is at most 64 tiles wide.
+//
+// Everything is little endian, offsets are from the start of
+// the file.
+///////////////////////////////////////////////////////////////
+const uint32_t TILEMAP_FILE_MAGIC = 0x50414D54; // "TMAP"
+const uint16_t TILEMAP_FILE_VERSION = 1;
+const uint16_t TILEMAP_FILE_HAS_COLLISION = 1 << 0;
+const uint16_t TILEMAP_DEFAULT_CHUNK_TILES = 32;
+const uint16_t TILEMAP_MAX_CHUNK_TILES = 64;
+const uint16_t TILEMAP_EMPTY_TILE = 0xFFFF;
+
+struct TilemapFileHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;
+  uint16_t columns;
+  uint16_t rows;
+  uint16_t chunk_tiles;
+  uint16_t chunk_columns;
+  uint16_t chunk_rows;
+  uint16_t reserved;
+  uint32_t directory_offset;
+  uint64_t file_size;
+};
+
+struct TilemapChunkEntry {
+  uint32_t tiles_offset;
+  uint32_t collision_offset;
+};
+
+static_assert(sizeof(TilemapFileHeader) == 32, "TilemapFileHeader is part of the file format");
+static_assert(sizeof(TilemapChunkEntry) == 8, "TilemapChunkEntry is part of the file format");
+
+// A parsed CSV map, only used on the way to the binary format
+struct TilemapGrid {
+  uint16_t columns = 0;
+  uint16_t rows = 0;
+  std::vector<uint16_t> tiles;
+};
+
+// Reads a CSV .map (see Tilemap.hpp), logs and returns false when it's malformed
+bool parse_tilemap_csv(const std::string& map_path, TilemapGrid& grid);
+
+// Builds the binary image of a grid. solid_tiles, indexed by tile, marks the tiles
+// that go in the collision masks; leave it empty for a map without collision
+std::vector<uint8_t> encode_tilemap(const TilemapGrid& grid, uint16_t chunk_tiles, const std::vector<bool>& solid_tiles);
+
+///////////////////////////////////////////////////////////////
+// Read-only view of a binary tilemap, either mmapped from disk
+// or an image built in memory (e.g. from a CSV). The file is
+// checked once when opened, after that every accessor is plain
+// pointer arithmetic into it.
+///////////////////////////////////////////////////////////////
+class TilemapFile {
+public:
+  TilemapFile();
+  ~TilemapFile();
+
+  TilemapFile(const TilemapFile&) = delete;
+  TilemapFile& operator=(const TilemapFile&) = delete;
+
+  bool open(const std::string& file_path);
+  bool open_image(std::vector<uint8_t>&& image);
+  void close();
+
+  bool is_open() const { return data != nullptr; }
+  const TilemapFileHeader& get_header() const { return *reinterpret_cast<const TilemapFileHeader*>(data); }
+  bool has_collision() const { return get_header().flags & TILEMAP_FILE_HAS_COLLISION; }
+
+  // nullptr = the chunk is empty
+  const uint16_t* get_chunk_tiles(uint16_t chunk_column, uint16_t chunk_row) const {
+    const TilemapChunkEntry& entry = get_chunk_entry(chunk_column, chunk_row);
+    return entry.tiles_offset ? reinterpret_cast<const uint16_t*>(data + entry.tiles_offset) : nullptr;
+  }
+
+  // One word per chunk row, nullptr = nothing in the chunk is solid
+  const uint64_t* get_chunk_collision(uint16_t chunk_column, uint16_t chunk_row) const {
+    const TilemapChunkEntry& entry = get_chunk_entry(chunk_column, chunk_row);
+    return entry.collision_offset ? reinterpret_cast<const uint64_t*>(data + entry.collision_offset) : nullptr;
+  }
+
+  uint16_t get_tile(uint16_t column, uint16_t row) const {
+    const uint16_t chunk_tiles = get_header().chunk_tiles;
+    const uint16_t* tiles = get_chunk_tiles(column / chunk_tiles, row / chunk_tiles);
+    return tiles ? tiles[(row % chunk_tiles) * chunk_tiles + column % chunk_tiles] : TILEMAP_EMPTY_TILE;
+  }
+
+private:
+  const uint8_t* data;
+  size_t size;
+  // Backing store when the image was built in memory
+  std::vector<uint8_t> image;
+  bool is_mapped;
+
+  const TilemapChunkEntry& get_chunk_entry(uint16_t chunk_column, uint16_t chunk_row) const {
+    const TilemapFileHeader& header = get_header();
+    return reinterpret_cast<const TilemapChunkEntry*>(data + header.directory_offset)[chunk_row * header.chunk_columns + chunk_column];
+  }
+
+  bool validate(const std::string& name) const;
+};
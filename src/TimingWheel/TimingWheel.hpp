@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Hierarchical timing wheel, the engine's timer service.
+//
+// Timers are bucketed by deadline (simulation clock ms) into
+// 4 wheels of 256 slots: the first holds the next 256ms one ms
+// per slot, each wheel above covers 256x the range of the one
+// below. When a lower wheel wraps, the next slot of the wheel
+// above is poured down into it. Advancing only ever touches
+// the slots being passed, so a tick costs O(timers expiring)
+// rather than O(timers alive).
+//
+// Payloads are handed back as is, the owner checks they are
+// still valid (entity alive, deadline unchanged) when they fire.
+///////////////////////////////////////////////////////////////
+template <typename T>
+class TimingWheel {
+public:
+  TimingWheel(uint32_t start_time = 0) : current_time{start_time}, num_of_timers{0} {}
+  ~TimingWheel() = default;
+
+  size_t size() const { return num_of_timers; }
+  uint32_t get_current_time() const { return current_time; }
+
+  // Deadlines already reached fire on the next advance
+  void schedule(uint32_t deadline, const T& payload) {
+    num_of_timers++;
+
+    if (deadline <= current_time)
+      ready.push_back({deadline, payload});
+    else
+      insert({deadline, payload});
+  }
+
+  // Moves the wheel forward to now, appending the payload of every
+  // timer whose deadline is <= now to expired, in deadline order
+  void advance(uint32_t now, std::vector<T>& expired) {
+    fire(ready, expired);
+
+    if (num_of_timers == 0) {
+      if (now > current_time) current_time = now;
+      return;
+    }
+
+    while (current_time < now) {
+      current_time++;
+
+      if ((current_time & SLOT_MASK) == 0)
+        cascade(1);
+
+      fire(wheels[0][current_time & SLOT_MASK], expired);
+    }
+  }
+
+private:
+  const static uint32_t LEVELS = 4;
+  const static uint32_t SLOT_BITS = 8;
+  const static uint32_t SLOTS = 1 << SLOT_BITS;
+  const static uint32_t SLOT_MASK = SLOTS - 1;
+
+  struct Timer {
+    uint32_t deadline;
+    T payload;
+  };
+
+  std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> wheels;
+  std::vector<Timer> ready;
+  uint32_t current_time;
+  size_t num_of_timers;
+
+  // The lowest wheel where deadline and now share every higher digit.
+  // A cascading timer due right now lands in the slot about to fire
+  void insert(const Timer& timer) {
+    for (uint32_t level = 0; level < LEVELS; level++) {
+      const uint32_t shift = SLOT_BITS * (level + 1);
+      if (level == LEVELS - 1 || (static_cast<uint64_t>(timer.deadline) >> shift) == (static_cast<uint64_t>(current_time) >> shift)) {
+        wheels[level][(timer.deadline >> (SLOT_BITS * level)) & SLOT_MASK].push_back(timer);
+        return;
+      }
+    }
+  }
+
+  // Wheel `level` reached a new slot, redistribute its timers below.
+  // If it wrapped too, the wheel above has to pour down first
+  void cascade(uint32_t level) {
+    const uint32_t index = (current_time >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    if (index == 0 && level + 1 < LEVELS)
+      cascade(level + 1);
+
+    std::vector<Timer> timers;
+    timers.swap(wheels[level][index]);
+    for (const auto& timer: timers)
+      insert(timer);
+  }
+
+  void fire(std::vector<Timer>& slot, std::vector<T>& expired) {
+    for (const auto& timer: slot)
+      expired.push_back(timer.payload);
+
+    num_of_timers -= slot.size();
+    slot.clear();
+  }
+};
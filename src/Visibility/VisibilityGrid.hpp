@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// Uniform grid of render bounds, rebuilt only when they change
+// and queried any number of times in between. Every box is
+// bucketed into each cell it touches, and a rect query only
+// walks the cells under the rect, so finding what's on screen
+// costs about what's on screen however big the world is.
+//
+// Boxes outside the grid are clamped into the border cells, the
+// exact overlap test in query() sorts them out.
+//
+// Same flat layout as TargetGrid: cell_start[c]..cell_start[c + 1]
+// is the run of boxes in cell c.
+///////////////////////////////////////////////////////////////
+class VisibilityGrid {
+public:
+  void reset(float width, float height, float new_cell_size) {
+    cell_size = new_cell_size;
+    columns = std::max(1, static_cast<int32_t>(width / cell_size) + 1);
+    rows = std::max(1, static_cast<int32_t>(height / cell_size) + 1);
+
+    min_x.clear();
+    min_y.clear();
+    max_x.clear();
+    max_y.clear();
+  }
+
+  // Boxes are numbered in the order they're added
+  void add(float x0, float y0, float x1, float y1) {
+    min_x.push_back(x0);
+    min_y.push_back(y0);
+    max_x.push_back(x1);
+    max_y.push_back(y1);
+  }
+
+  void build() {
+    cell_start.assign(columns * rows + 1, 0);
+
+    for (uint32_t box = 0; box < min_x.size(); box++)
+      for_each_cell(box, [this](int32_t cell) { cell_start[cell + 1]++; });
+
+    for (uint32_t c = 0; c < cell_start.size() - 1; c++)
+      cell_start[c + 1] += cell_start[c];
+
+    cell_boxes.resize(cell_start.back());
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+
+    for (uint32_t box = 0; box < min_x.size(); box++)
+      for_each_cell(box, [this, box](int32_t cell) { cell_boxes[cell_fill[cell]++] = box; });
+
+    seen.assign(min_x.size(), 0);
+    query_stamp = 0;
+  }
+
+  // Calls found(box) once for every box overlapping the rect
+  template <typename T_func>
+  void query(float x0, float y0, float x1, float y1, T_func&& found) {
+    const int32_t first_column = clamp_column(x0);
+    const int32_t last_column = clamp_column(x1);
+    const int32_t first_row = clamp_row(y0);
+    const int32_t last_row = clamp_row(y1);
+    // The grid outlives a query, a box counts as seen when it's marked with this one's stamp
+    if (++query_stamp == 0) {
+      seen.assign(seen.size(), 0);
+      query_stamp = 1;
+    }
+
+    for (int32_t row = first_row; row <= last_row; row++) {
+      for (int32_t column = first_column; column <= last_column; column++) {
+        const int32_t cell = row * columns + column;
+        for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+          const uint32_t box = cell_boxes[i];
+          // Big boxes sit in several cells, report them once
+          if (seen[box] == query_stamp) continue;
+          seen[box] = query_stamp;
+
+          if (x0 < max_x[box] && x1 > min_x[box] && y0 < max_y[box] && y1 > min_y[box])
+            found(box);
+        }
+      }
+    }
+  }
+
+  uint32_t size() const { return static_cast<uint32_t>(min_x.size()); }
+
+private:
+  float cell_size = 256.0f;
+  int32_t columns = 1;
+  int32_t rows = 1;
+
+  std::vector<float> min_x;
+  std::vector<float> min_y;
+  std::vector<float> max_x;
+  std::vector<float> max_y;
+
+  std::vector<uint32_t> cell_start;
+  std::vector<uint32_t> cell_fill;
+  std::vector<uint32_t> cell_boxes;
+  std::vector<uint32_t> seen;
+  uint32_t query_stamp = 0;
+
+  // Clamped as floats, a far off box must not overflow the cast
+  int32_t clamp_column(float x) const { return static_cast<int32_t>(std::min(static_cast<float>(columns - 1), std::max(0.0f, x / cell_size))); }
+  int32_t clamp_row(float y) const { return static_cast<int32_t>(std::min(static_cast<float>(rows - 1), std::max(0.0f, y / cell_size))); }
+
+  template <typename T_func>
+  void for_each_cell(uint32_t box, T_func&& func) const {
+    const int32_t first_column = clamp_column(min_x[box]);
+    const int32_t last_column = clamp_column(max_x[box]);
+    const int32_t first_row = clamp_row(min_y[box]);
+    const int32_t last_row = clamp_row(max_y[box]);
+
+    for (int32_t row = first_row; row <= last_row; row++)
+      for (int32_t column = first_column; column <= last_column; column++)
+        func(row * columns + column);
+  }
+};
@@ -1,9 +1,77 @@
 #include "Game/Game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
-int main()
+static void print_usage(const char* program) {
+  std::fprintf(stderr,
+    "usage: %s [options]\n"
+    "  --level N            level to load (1 = space, 2 = jungle)\n"
+    "  --scenario FILE      spawn a bench scenario on top of its level\n"
+    "  --frames N           quit after N frames\n"
+    "  --no-render-thread   simulate and render on the main thread\n"
+    "  --headless           no window or GPU, draw into an offscreen surface\n"
+    "  --size WxH           headless frame size (default %ux%u)\n"
+    "  --hash               headless, print a hash of every frame\n"
+    "  --capture DIR        headless, write every frame to DIR as a PPM\n",
+    program, DEFAULT_HEADLESS_WIDTH, DEFAULT_HEADLESS_HEIGHT);
+}
+
+// Game settings from the command line, false on anything it doesn't understand
+static bool parse_arguments(int argc, char* argv[], Game& game) {
+  for (int i = 1; i < argc; i++) {
+    const std::string option = argv[i];
+    const bool has_value = i + 1 < argc;
+
+    if (option == "--headless") {
+      game.headless_enabled = true;
+    }
+    else if (option == "--hash") {
+      game.frame_hash_enabled = true;
+    }
+    else if (option == "--no-render-thread") {
+      game.render_thread_enabled = false;
+    }
+    else if (option == "--level" && has_value) {
+      game.starting_level = std::atoi(argv[++i]);
+    }
+    else if (option == "--scenario" && has_value) {
+      game.scenario = std::make_unique<Scenario>();
+      if (!load_scenario(argv[++i], *game.scenario)) return false;
+    }
+    else if (option == "--frames" && has_value) {
+      game.max_frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (option == "--capture" && has_value) {
+      game.capture_directory = argv[++i];
+    }
+    else if (option == "--size" && has_value) {
+      unsigned int width = 0;
+      unsigned int height = 0;
+      if (std::sscanf(argv[++i], "%ux%u", &width, &height) != 2 || width == 0 || height == 0 || width > UINT16_MAX || height > UINT16_MAX) {
+        std::fprintf(stderr, "--size takes WIDTHxHEIGHT, e.g. 1280x720\n");
+        return false;
+      }
+      game.headless_width = static_cast<uint16_t>(width);
+      game.headless_height = static_cast<uint16_t>(height);
+    }
+    else {
+      std::fprintf(stderr, "unknown option %s\n", option.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char* argv[])
 {
   Game game;
 
+  if (!parse_arguments(argc, argv, game)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
   game.Initialize();
   game.Run();
   game.Destroy();
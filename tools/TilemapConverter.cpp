@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////
+// Converts a CSV .map into the binary tilemap format the game
+// mmaps at load time (see src/Tilemap/TilemapFile.hpp).
+//
+// make tilemapconv && ./TilemapConverter in.map out.tilemap [--chunk N] [--solid 0,1,2]
+//
+// --chunk  chunk side in tiles, 1-64 (default 32)
+// --solid  tileset indices that block movement, written to the
+//          per-chunk collision masks; without it the map has none
+///////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/Tilemap/TilemapFile.hpp"
+
+static bool parse_solid_tiles(const std::string& list, std::vector<bool>& solid_tiles) {
+  std::stringstream tiles(list);
+  std::string tile;
+  while (std::getline(tiles, tile, ',')) {
+    char* end = nullptr;
+    const long index = std::strtol(tile.c_str(), &end, 10);
+    if (end == tile.c_str() || index < 0 || index >= TILEMAP_EMPTY_TILE) return false;
+
+    if (static_cast<size_t>(index) >= solid_tiles.size()) solid_tiles.resize(index + 1, false);
+    solid_tiles[index] = true;
+  }
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s in.map out.tilemap [--chunk N] [--solid 0,1,2]\n", argv[0]);
+    return 1;
+  }
+
+  const std::string input_path = argv[1];
+  const std::string output_path = argv[2];
+  uint16_t chunk_tiles = TILEMAP_DEFAULT_CHUNK_TILES;
+  std::vector<bool> solid_tiles;
+
+  for (int i = 3; i < argc; i++) {
+    const std::string option = argv[i];
+    if (option == "--chunk" && i + 1 < argc) {
+      const int value = std::atoi(argv[++i]);
+      if (value < 1 || value > TILEMAP_MAX_CHUNK_TILES) {
+        std::fprintf(stderr, "--chunk must be between 1 and %u\n", TILEMAP_MAX_CHUNK_TILES);
+        return 1;
+      }
+      chunk_tiles = static_cast<uint16_t>(value);
+    }
+    else if (option == "--solid" && i + 1 < argc) {
+      if (!parse_solid_tiles(argv[++i], solid_tiles)) {
+        std::fprintf(stderr, "--solid takes a comma separated list of tile indices\n");
+        return 1;
+      }
+    }
+    else {
+      std::fprintf(stderr, "unknown option %s\n", option.c_str());
+      return 1;
+    }
+  }
+
+  TilemapGrid grid;
+  if (!parse_tilemap_csv(input_path, grid)) return 1;
+
+  const std::vector<uint8_t> image = encode_tilemap(grid, chunk_tiles, solid_tiles);
+
+  // Load it back the way the game will, a file that doesn't validate never gets written
+  TilemapFile check;
+  if (!check.open_image(std::vector<uint8_t>(image))) return 1;
+
+  std::ofstream output(output_path, std::ios::binary);
+  output.write(reinterpret_cast<const char*>(image.data()), image.size());
+  if (!output) {
+    std::fprintf(stderr, "failed writing %s\n", output_path.c_str());
+    return 1;
+  }
+
+  std::printf("%s: %ux%u tiles, %ux%u chunks of %u, %zu bytes%s\n",
+              output_path.c_str(), grid.columns, grid.rows,
+              check.get_header().chunk_columns, check.get_header().chunk_rows, chunk_tiles,
+              image.size(), check.has_collision() ? ", with collision" : "");
+  return 0;
+}